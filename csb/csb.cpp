@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <format>
+#include <iterator>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -194,9 +195,36 @@ int csb::build()
 
   csb::compile();
   csb::link();
-  return csb::run();
+  if (csb::is_subproject) return csb::success;
+
+  csb::target_name = "cse_benchmark";
+  csb::target_artifact = EXECUTABLE;
+  csb::include_files = csb::combine<std::filesystem::path>(
+    {csb::include_files,
+     csb::choose_files({"program/benchmark"}, [](const auto &file) { return file.extension() == ".hpp"; })});
+  csb::source_files =
+    csb::choose_files({"program/benchmark"}, [](const auto &file) { return file.extension() == ".cpp"; });
+  csb::library_directories.push_back(build_library_path);
+  csb::libraries = {"cse", "SDL3_mixer", "opusfile", "opus", "ogg",
+                    csb::host_platform == WINDOWS ? "SDL3-static" : "SDL3"};
+  if (csb::host_platform == WINDOWS)
+    csb::libraries.insert(csb::libraries.end(), {"user32", "gdi32", "winmm", "imm32", "ole32", "oleaut32", "version",
+                                                 "uuid", "advapi32", "setupapi", "shell32"});
+  else
+    csb::libraries.insert(csb::libraries.end(), {"m", "pthread", "dl"});
+  csb::compile();
+  csb::link();
+  return csb::success;
 }
 
-int csb::run() { return csb::success; }
+int csb::run()
+{
+  csb::target_name = "cse_benchmark";
+  csb::target_artifact = EXECUTABLE;
+  const std::vector<std::string> counts{
+    csb::arguments.empty() ? csb::arguments.begin() : std::next(csb::arguments.begin()), csb::arguments.end()};
+  csb::run_target(counts);
+  return csb::success;
+}
 
 CSB_MAIN()
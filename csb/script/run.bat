@@ -2,4 +2,4 @@
 
 call csb\script\internal\bootstrap.bat
 if errorlevel 1 exit /b %errorlevel%
-build\csb.exe run
+build\csb.exe run %*
@@ -1,4 +1,4 @@
 #!/bin/bash
 
 ./csb/script/internal/bootstrap.sh || exit $?
-./build/csb run
+./build/csb run "$@"
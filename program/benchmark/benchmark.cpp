@@ -0,0 +1,467 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+#include "SDL3/SDL_timer.h"
+#include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
+#include "nlohmann/json.hpp"
+
+#include "camera.hpp"
+#include "collision.hpp"
+#include "exception.hpp"
+#include "game.hpp"
+#include "harness.hpp"
+#include "histogram.hpp"
+#include "interface.hpp"
+#include "light.hpp"
+#include "main.hpp"
+#include "object.hpp"
+#include "print.hpp"
+#include "resource.hpp"
+#include "scene.hpp"
+#include "window.hpp"
+
+namespace cse::help::benchmark
+{
+  cse::texture::source sheet(const bool duplicated)
+  {
+    static const auto pixels{[]()
+                             {
+                               std::array<unsigned char, 64 * 16 * 4> result{};
+                               for (std::size_t index{}; index < result.size(); ++index)
+                                 result.at(index) = static_cast<unsigned char>(index % 4 == 3 ? 255 : index * 37);
+                               return result;
+                             }()};
+    static const std::array<cse::hitbox, 1> single{{{"body", 2.0, 14.0, 14.0, 2.0}}};
+    static const std::array<cse::hitbox, 2> twins{{{"body", 2.0, 14.0, 14.0, 2.0}, {"body", 5.0, 11.0, 11.0, 5.0}}};
+    const auto build{[](const std::span<const cse::hitbox> hitboxes)
+                     {
+                       std::array<cse::animation::frame, 4> result{};
+                       for (std::size_t index{}; index < result.size(); ++index)
+                         result.at(index) = {
+                           {static_cast<double>(index) / 4.0, 1.0, static_cast<double>(index + 1) / 4.0, 0.0},
+                           0.1,
+                           {7.5, 7.5},
+                           hitboxes};
+                       return result;
+                     }};
+    static const auto single_frames{build(single)};
+    static const auto twin_frames{build(twins)};
+    return {.image = {.data = pixels, .width = 64, .height = 16, .frame_width = 16, .frame_height = 16, .channels = 4},
+            .animation = {.frames = duplicated ? std::span<const cse::animation::frame>{twin_frames}
+                                               : std::span<const cse::animation::frame>{single_frames}}};
+  }
+
+  cse::text::source typeface()
+  {
+    static const auto pixels{[]()
+                             {
+                               std::array<unsigned char, 44 * 6 * 4> result{};
+                               for (std::size_t index{}; index < result.size(); ++index)
+                                 result.at(index) =
+                                   static_cast<unsigned char>(index % 4 == 3 || (index / 4) % 3 == 0 ? 255 : 0);
+                               return result;
+                             }()};
+    static const auto glyphs{[]()
+                             {
+                               std::array<cse::font::glyph, 11> result{};
+                               for (std::size_t index{}; index < result.size(); ++index)
+                                 result.at(index) = {index == 0 ? std::uint64_t{'#'} : std::uint64_t{'0'} + index - 1,
+                                                     {static_cast<double>(index) / 11.0, 1.0,
+                                                      static_cast<double>(index + 1) / 11.0, 0.0},
+                                                     4.0,
+                                                     6.0};
+                               return result;
+                             }()};
+    static const std::array<cse::animation::frame, 1> frames{{{{0.0, 1.0, 1.0, 0.0}, 0.0, {}, {}}}};
+    return {.font = {.image = {.data = pixels, .width = 44, .height = 6, .frame_width = 44, .frame_height = 6,
+                               .channels = 4},
+                     .glyphs = glyphs},
+            .animation = {.frames = frames}};
+  }
+
+  glm::dvec3 place(const std::size_t index, const std::size_t count)
+  {
+    const auto columns{static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))))};
+    const auto column{static_cast<double>(index % columns)};
+    const auto row{static_cast<double>(index / columns)};
+    const auto half{static_cast<double>(columns) / 2.0};
+    return {(column - half) * 10.0, (row - half) * 10.0, -static_cast<double>(index % 2)};
+  }
+
+  std::vector<layout> arrange(const scenario kind, const std::size_t count)
+  {
+    std::minstd_rand random{static_cast<std::minstd_rand::result_type>(kind + 1)};
+    const auto span{std::sqrt(static_cast<double>(count)) * 12.0};
+    std::uniform_real_distribution<double> spread{-span / 2.0, span / 2.0};
+    std::normal_distribution<double> cluster{0.0, 12.0};
+    std::uniform_int_distribution<std::uint64_t> mask{1, 15};
+    std::uniform_int_distribution<std::size_t> label{0, std::size(::collider::detail::list) - 1};
+    std::array<glm::dvec2, 8> centers{};
+    for (auto &center : centers) center = {spread(random), spread(random)};
+    const std::array layers{::collider::actor, ::collider::hazard, ::collider::pickup, ::collider::terrain};
+    const std::array targets{::collider::hazard | ::collider::pickup | ::collider::terrain, ::collider::actor,
+                             ::collider::none, ::collider::none};
+    const auto pick{[&layers](const std::uint64_t bits)
+                    {
+                      cse::collider result{};
+                      for (std::size_t bit{}; bit < layers.size(); ++bit)
+                        if ((bits >> bit) & 1u) result |= layers.at(bit);
+                      return result;
+                    }};
+    const auto band{[&label, &random]()
+                    {
+                      return cse::help::collision::forge<::collider::detail::list>(
+                        ::collider::detail::list[label(random)]);
+                    }};
+
+    std::vector<layout> result{};
+    result.reserve(count);
+    for (std::size_t index{}; index < count; ++index)
+    {
+      layout entry{.translation = {spread(random), spread(random), -static_cast<double>(index % 2)},
+                   .self = layers.at(index % 4),
+                   .target = targets.at(index % 4)};
+      if (kind == CLUSTERED)
+      {
+        const auto &center{centers.at(index % centers.size())};
+        entry.translation.x = center.x + cluster(random);
+        entry.translation.y = center.y + cluster(random);
+        entry.fixed = index % 4 == 3;
+      }
+      else if (kind == MIXED && index % 50 == 0)
+        entry.scale = {24.0, 24.0};
+      else if (kind == LAYERED)
+      {
+        entry.self = pick(mask(random));
+        entry.target = pick(mask(random));
+      }
+      else if (kind == BANDED)
+      {
+        entry.self = band();
+        entry.target = band() | band() | band() | band();
+      }
+      else if (kind == DUPLICATED)
+        entry.duplicated = true;
+      result.push_back(entry);
+    }
+    return result;
+  }
+
+  display::display() : cse::window({.title = "CSEngine Benchmark"}) {}
+
+  viewpoint::viewpoint() : cse::camera({.translation = {{0.0, 0.0, 160.0}}}) {}
+
+  sprite::sprite(const std::size_t index_, const std::size_t count_)
+    : cse::object({.translation = {place(index_, count_)},
+                   .collider = {.self = std::array{::collider::actor, ::collider::hazard, ::collider::pickup,
+                                                   ::collider::terrain}
+                                          .at(index_ % 4),
+                                .target = std::array{::collider::hazard | ::collider::pickup | ::collider::terrain,
+                                                     ::collider::actor, ::collider::none, ::collider::none}
+                                            .at(index_ % 4)},
+                   .texture = {.source = sheet(false),
+                               .playback = {.frame = index_ % 4, .playing = true, .speed = {1.0}, .loop = true}},
+                   .text = index_ % 8 == 0 ? help::object::text{.content = {std::format("#{}", index_)},
+                                                                .source = typeface(),
+                                                                .align = {.vertical = {.preset = TOP},
+                                                                          .offset = {{0.0, -4.0}}}}
+                                           : help::object::text{},
+                   .priority = {.simulation = 0, .rendering = static_cast<int>(index_ % 3), .parallel = true}}),
+      origin{place(index_, count_)}
+  {
+  }
+
+  void sprite::on_simulate(const double tick)
+  {
+    elapsed += tick;
+    active.translation.value.x = origin.x + std::floor((std::sin(elapsed + origin.y) * 4.0) + 0.5);
+  }
+
+  crate::crate(const layout &layout_, const std::size_t index_)
+    : cse::object({.translation = {layout_.translation},
+                   .scale = {layout_.scale},
+                   .collider = {.self = layout_.self, .target = layout_.target, .fixed = layout_.fixed},
+                   .texture = {.source = sheet(layout_.duplicated), .playback = {.frame = index_ % 4}}}),
+      index{index_}
+  {
+  }
+
+  void crate::on_simulate(const double)
+  {
+    if (active.collider.fixed || index % 4 != 0) return;
+    active.translation.value.x += (steps++ % 8) < 4 ? 1.0 : -1.0;
+  }
+
+  lamp::lamp(const std::size_t index_, const std::size_t count_)
+    : cse::light({.translation = {place(index_ * 50, count_) + glm::dvec3{0.0, 0.0, 8.0}},
+                  .illumination = {.brightness = {{1.0, 0.9, 0.8, 1.0}}, .shape = {.range = {48.0}}},
+                  .shadow = {.cast = index_ % 2 == 0}})
+  {
+  }
+
+  panel::panel(const std::size_t index_, const std::size_t count_)
+    : cse::interface({.translation = {glm::dvec2{place(index_, count_)} / 4.0},
+                      .interactable = index_ % 2 == 0,
+                      .texture = {.source = sheet(false), .playback = {.frame = index_ % 4}},
+                      .text = index_ % 4 == 0 ? help::interface::text{.content = {std::format("#{}", index_)},
+                                                                      .source = typeface()}
+                                              : help::interface::text{},
+                      .priority = {.simulation = static_cast<int>(index_ % 3),
+                                   .rendering = static_cast<int>(index_ % 5)}})
+  {
+  }
+}
+
+namespace cse
+{
+  benchmark::benchmark(const std::vector<std::size_t> &counts_)
+    : game({.tick = 100.0,
+            .frame = 100.0,
+            .headless = {.enabled = true, .render = true, .unthrottled = true}}),
+      counts(counts_)
+  {
+  }
+
+  void benchmark::setup(const std::shared_ptr<benchmark> &benchmark_)
+  {
+    benchmark_->set<help::benchmark::display>();
+    benchmark_->current("idle", [](const std::shared_ptr<help::benchmark::stage> &stage)
+                        { stage->set<help::benchmark::viewpoint>(); });
+  }
+
+  void benchmark::post_create()
+  {
+    help::harness::blend(*this, 0.5);
+    print<COUT>("{:>7} {:<34} {:>5} {:>10} {:>10} {:>10} {:>10}\n", "count", "phase", "iters", "mean ms", "p50 ms",
+                "p95 ms", "max ms");
+    for (const auto count : counts) sweep(count);
+    print<COUT>("\n{:>7} {:<34} {:>5} {:>10} {:>10} {:>10} {:>6} {:>8} {:>8} {:>9}\n", "count", "scenario", "iters",
+                "mean ms", "p95 ms", "ns/entry", "shift", "load", "per cell", "contacts");
+    for (const auto count : counts)
+      for (std::size_t kind{}; kind < help::benchmark::scenarios.size(); ++kind)
+        probe(static_cast<help::benchmark::scenario>(kind), count);
+    write();
+    active.window->active.running = false;
+  }
+
+  void benchmark::sweep(const std::size_t count)
+  {
+    auto stage{std::make_shared<help::benchmark::stage>()};
+    stage->game = this;
+    stage->set<help::benchmark::viewpoint>();
+    for (std::size_t index{}; index < count; ++index)
+      stage->set<help::benchmark::sprite>(std::format("sprite_{}", index), index, count);
+    for (std::size_t index{}; index < (count / 50) + 1; ++index)
+      stage->set<help::benchmark::lamp>(std::format("lamp_{}", index), index, count);
+    const auto panels{(count / 20) + 1};
+    for (std::size_t index{}; index < panels; ++index)
+      stage->set<help::benchmark::panel>(std::format("panel_{}", index), index, panels);
+    help::harness::prepare(*stage);
+    help::harness::create(*stage);
+    help::harness::synchronize(*stage);
+    const auto idle{help::harness::attach(*this, stage)};
+    help::harness::render(*stage, *this);
+
+    std::array<help::histogram, help::benchmark::phases.size()> histograms{};
+    std::array<double, help::benchmark::phases.size()> totals{};
+    const auto measure{[&](const std::size_t phase, const auto &function)
+                       {
+                         const auto start{clock()};
+                         function();
+                         const auto duration{clock() - start};
+                         histograms.at(phase).record(duration);
+                         totals.at(phase) += duration;
+                       }};
+    auto &scene{*stage};
+    std::size_t iterations{};
+    for (const auto start{clock()}; iterations < minimum || (iterations < maximum && clock() - start < budget);
+         ++iterations)
+    {
+      help::harness::simulate(scene, help::harness::tick(*this));
+      measure(0, [&]() { help::harness::synchronize(scene); });
+      measure(1, [&]() { help::harness::order(scene); });
+      measure(2, [&]() { help::harness::contacts(scene, *this); });
+      measure(3, [&]() { help::harness::graphics(scene, *this); });
+      measure(4, [&]() { help::harness::sequence(*this); });
+      measure(5, [&]() { help::harness::pool(*this); });
+      measure(6, [&]() { help::harness::layers(*this); });
+      measure(7, [&]() { help::harness::frustum(*this); });
+      measure(8, [&]() { help::harness::text(*this, scene); });
+      measure(9, [&]() { help::harness::lights(*this, scene); });
+      measure(10, [&]() { help::harness::occluders(*this, scene); });
+      measure(11, [&]() { help::harness::objects(*this, scene); });
+      measure(12, [&]() { help::harness::interfaces(*this); });
+    }
+    help::harness::attach(*this, idle);
+    help::harness::destroy(*stage);
+    help::harness::clean(*stage);
+
+    for (std::size_t phase{}; phase < help::benchmark::phases.size(); ++phase)
+    {
+      const auto &histogram{histograms.at(phase)};
+      const auto &result{results.emplace_back(help::benchmark::result{
+        count, help::benchmark::phases.at(phase), iterations,
+        totals.at(phase) * 1000.0 / static_cast<double>(iterations), histogram.percentile(0.5) * 1000.0,
+        histogram.percentile(0.95) * 1000.0, histogram.percentile(0.99) * 1000.0, histogram.maximum() * 1000.0})};
+      print<COUT>("{:>7} {:<34} {:>5} {:>10.4f} {:>10.4f} {:>10.4f} {:>10.4f}\n", result.count, result.phase,
+                  result.iterations, result.mean, result.p50, result.p95, result.maximum);
+    }
+  }
+
+  void benchmark::probe(const help::benchmark::scenario kind, const std::size_t count)
+  {
+    const auto scenario{help::benchmark::scenarios.at(kind)};
+    auto stage{std::make_shared<help::benchmark::stage>()};
+    stage->game = this;
+    stage->set<help::benchmark::viewpoint>();
+    const auto layouts{help::benchmark::arrange(kind, count)};
+    for (std::size_t index{}; index < layouts.size(); ++index)
+      stage->set<help::benchmark::crate>(std::format("crate_{}", index), layouts.at(index), index);
+    help::harness::prepare(*stage);
+    help::harness::create(*stage);
+    help::harness::synchronize(*stage);
+
+    help::histogram histogram{};
+    double total{};
+    std::size_t iterations{};
+    for (const auto start{clock()}; iterations < minimum || (iterations < maximum && clock() - start < budget);
+         ++iterations)
+    {
+      help::harness::simulate(*stage, help::harness::tick(*this));
+      help::harness::synchronize(*stage);
+      const auto begin{clock()};
+      help::harness::contacts(*stage, *this);
+      const auto duration{clock() - begin};
+      histogram.record(duration);
+      total += duration;
+      if (count <= checked && iterations % 16 == 0) verify(*stage, scenario);
+    }
+
+    const auto occupancy{help::harness::measure(*stage)};
+    const auto load{static_cast<double>(occupancy.slots) /
+                    static_cast<double>(std::max<std::size_t>(occupancy.buckets, 1))};
+    const auto per_cell{static_cast<double>(occupancy.members) /
+                        static_cast<double>(std::max<std::size_t>(occupancy.cells, 1))};
+    const auto mean{total / static_cast<double>(iterations)};
+    const auto per_entry{mean * 1e9 / static_cast<double>(std::max<std::size_t>(occupancy.entries, 1))};
+    const auto shift{occupancy.shift};
+    const auto contacts{stage->active.contacts.size()};
+    help::harness::destroy(*stage);
+    help::harness::clean(*stage);
+
+    const auto &result{results.emplace_back(help::benchmark::result{
+      count, scenario, iterations, mean * 1000.0, histogram.percentile(0.5) * 1000.0,
+      histogram.percentile(0.95) * 1000.0, histogram.percentile(0.99) * 1000.0, histogram.maximum() * 1000.0})};
+    print<COUT>("{:>7} {:<34} {:>5} {:>10.4f} {:>10.4f} {:>10.1f} {:>6} {:>8.3f} {:>8.2f} {:>9}\n", result.count,
+                result.phase, result.iterations, result.mean, result.p95, per_entry, shift, load, per_cell, contacts);
+  }
+
+  void benchmark::verify(const help::benchmark::stage &stage, const std::string_view scenario)
+  {
+    using key = std::tuple<std::uint64_t, std::uint64_t, std::uint64_t, std::uint64_t>;
+    const auto area{[](const cse::hitbox &first, const cse::hitbox &second)
+                    {
+                      return (std::min(first.right, second.right) - std::max(first.left, second.left)) *
+                             (std::min(first.top, second.top) - std::max(first.bottom, second.bottom));
+                    }};
+    std::map<key, double> expected{};
+    for (const auto &self : stage.active.objects)
+      for (const auto &target : stage.active.objects)
+      {
+        const auto &own{self->active.collider};
+        const auto &theirs{target->active.collider};
+        if (self == target || !own.target.intersects(theirs.self) || (own.fixed && theirs.fixed)) continue;
+        if (std::floor(self->active.translation.value.z + 0.5) != std::floor(target->active.translation.value.z + 0.5))
+          continue;
+        for (const auto &first : self->hitboxes())
+          for (const auto &second : target->hitboxes())
+          {
+            if (first.right <= first.left || first.top <= first.bottom || second.right <= second.left ||
+                second.top <= second.bottom || !help::collision::overlaps(first, second))
+              continue;
+            auto &kept{expected[{self->name.identifier(), target->name.identifier(), first.name.identifier(),
+                                 second.name.identifier()}]};
+            kept = std::max(kept, area(first, second));
+          }
+      }
+
+    std::map<key, double> actual{};
+    for (const auto &contact : stage.active.contacts)
+      if (!actual
+             .emplace(key{contact.self.name.identifier(), contact.target.pointer->name.identifier(),
+                          contact.self.hitbox.name.identifier(), contact.target.hitbox.name.identifier()},
+                      contact.overlap.x * contact.overlap.y)
+             .second)
+        throw exception("Collision scenario '{}' generated the same contact twice", scenario);
+    if (actual != expected)
+      throw exception("Collision scenario '{}' generated {} contacts where the brute-force oracle expects {}", scenario,
+                      actual.size(), expected.size());
+  }
+
+  void benchmark::write() const
+  {
+    const std::filesystem::path csv{"benchmark.csv"};
+    const std::filesystem::path json{"benchmark.json"};
+    std::string table{"count,phase,iterations,mean_ms,p50_ms,p95_ms,p99_ms,maximum_ms\n"};
+    nlohmann::json document{{"counts", counts}, {"results", nlohmann::json::array()}};
+    for (const auto &result : results)
+    {
+      table += std::format("{},{},{},{:.6f},{:.6f},{:.6f},{:.6f},{:.6f}\n", result.count, result.phase,
+                           result.iterations, result.mean, result.p50, result.p95, result.p99, result.maximum);
+      document["results"].push_back({{"count", result.count},
+                                     {"phase", std::string{result.phase}},
+                                     {"iterations", result.iterations},
+                                     {"mean_ms", result.mean},
+                                     {"p50_ms", result.p50},
+                                     {"p95_ms", result.p95},
+                                     {"p99_ms", result.p99},
+                                     {"maximum_ms", result.maximum}});
+    }
+    std::ofstream csv_stream{csv, std::ios_base::binary};
+    csv_stream << table;
+    if (!csv_stream) throw exception("Could not write benchmark results to '{}'", csv.string());
+    std::ofstream json_stream{json, std::ios_base::binary};
+    json_stream << document.dump(2);
+    if (!json_stream) throw exception("Could not write benchmark results to '{}'", json.string());
+    print<COUT>("Wrote {} results to '{}' and '{}'\n", results.size(), std::filesystem::absolute(csv).string(),
+                std::filesystem::absolute(json).string());
+  }
+
+  double benchmark::clock() { return static_cast<double>(SDL_GetTicksNS()) / 1e9; }
+}
+
+auto cse::main(const arglist &arguments) -> application
+{
+  std::vector<std::size_t> counts{};
+  for (std::size_t index{1}; index < arguments.size(); ++index)
+  {
+    const auto argument{arguments.at(index)};
+    std::size_t count{};
+    const auto [end, error]{std::from_chars(argument.data(), argument.data() + argument.size(), count)};
+    if (error != std::errc{} || end != argument.data() + argument.size() || count == 0)
+      throw exception("Expected a positive entity count, got '{}'", argument);
+    counts.push_back(count);
+  }
+  if (counts.empty()) counts = {100, 1000, 10000, 100000};
+  return {game::create<benchmark>(benchmark::setup, counts), {"CSEngine", "Benchmark", "1.0.0"}};
+}
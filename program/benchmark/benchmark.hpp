@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
+
+#include "camera.hpp"
+#include "collision.hpp"
+#include "game.hpp"
+#include "interface.hpp"
+#include "light.hpp"
+#include "object.hpp"
+#include "resource.hpp"
+#include "scene.hpp"
+#include "window.hpp"
+
+COLLIDERS(actor, hazard, pickup, terrain, band_04, band_05, band_06, band_07, band_08, band_09, band_10, band_11,
+          band_12, band_13, band_14, band_15, band_16, band_17, band_18, band_19, band_20, band_21, band_22, band_23,
+          band_24, band_25, band_26, band_27, band_28, band_29, band_30, band_31, band_32, band_33, band_34, band_35,
+          band_36, band_37, band_38, band_39, band_40, band_41, band_42, band_43, band_44, band_45, band_46, band_47,
+          band_48, band_49, band_50, band_51, band_52, band_53, band_54, band_55, band_56, band_57, band_58, band_59,
+          band_60, band_61, band_62, band_63, band_64, band_65, band_66, band_67, band_68, band_69, band_70, band_71,
+          band_72, band_73, band_74, band_75, band_76, band_77, band_78, band_79, band_80, band_81, band_82, band_83,
+          band_84, band_85, band_86, band_87, band_88, band_89, band_90, band_91, band_92, band_93, band_94, band_95);
+
+namespace cse::help::benchmark
+{
+  inline constexpr std::array<std::string_view, 13> phases{"scene::synchronize",
+                                                           "scene::generate_simulation_order",
+                                                           "scene::generate_contacts",
+                                                           "scene::generate_graphics_order",
+                                                           "game::generate_simulation_order",
+                                                           "game::generate_pool",
+                                                           "game::generate_graphics_order",
+                                                           "game::generate_frustum",
+                                                           "game::generate_text",
+                                                           "game::generate_lights",
+                                                           "game::generate_occluders",
+                                                           "game::generate_objects",
+                                                           "game::generate_interfaces"};
+
+  enum scenario : std::size_t
+  {
+    UNIFORM,
+    CLUSTERED,
+    MIXED,
+    LAYERED,
+    BANDED,
+    DUPLICATED
+  };
+  inline constexpr std::array<std::string_view, 6> scenarios{"collision::uniform", "collision::clustered",
+                                                             "collision::mixed",   "collision::layered",
+                                                             "collision::banded",  "collision::duplicated"};
+
+  struct result
+  {
+    std::size_t count{};
+    std::string_view phase{};
+    std::size_t iterations{};
+    double mean{};
+    double p50{};
+    double p95{};
+    double p99{};
+    double maximum{};
+  };
+  struct layout
+  {
+    glm::dvec3 translation{};
+    glm::dvec2 scale{1.0, 1.0};
+    cse::collider self{};
+    cse::collider target{};
+    bool fixed{};
+    bool duplicated{};
+  };
+
+  cse::texture::source sheet(const bool duplicated);
+  cse::text::source typeface();
+  glm::dvec3 place(const std::size_t index, const std::size_t count);
+  std::vector<layout> arrange(const scenario kind, const std::size_t count);
+
+  class display final : public cse::window
+  {
+  public:
+    display();
+  };
+
+  class stage final : public cse::scene
+  {
+  public:
+    stage() = default;
+  };
+
+  class viewpoint final : public cse::camera
+  {
+  public:
+    viewpoint();
+  };
+
+  class sprite final : public cse::object
+  {
+  public:
+    sprite(const std::size_t index_, const std::size_t count_);
+
+  protected:
+    void on_simulate(const double tick) final;
+
+  private:
+    glm::dvec3 origin{};
+    double elapsed{};
+  };
+
+  class crate final : public cse::object
+  {
+  public:
+    crate(const layout &layout_, const std::size_t index_);
+
+  protected:
+    void on_simulate(const double tick) final;
+
+  private:
+    std::size_t index{};
+    std::size_t steps{};
+  };
+
+  class lamp final : public cse::light
+  {
+  public:
+    lamp(const std::size_t index_, const std::size_t count_);
+  };
+
+  class panel final : public cse::interface
+  {
+  public:
+    panel(const std::size_t index_, const std::size_t count_);
+  };
+}
+
+namespace cse
+{
+  class benchmark final : public game
+  {
+  public:
+    explicit benchmark(const std::vector<std::size_t> &counts_);
+    static void setup(const std::shared_ptr<benchmark> &benchmark_);
+
+  protected:
+    void post_create() final;
+
+  private:
+    void sweep(const std::size_t count);
+    void probe(const help::benchmark::scenario kind, const std::size_t count);
+    static void verify(const help::benchmark::stage &stage, const std::string_view scenario);
+    void write() const;
+    static double clock();
+
+  private:
+    static constexpr std::size_t minimum{5};
+    static constexpr std::size_t maximum{1000};
+    static constexpr double budget{1.0};
+    static constexpr std::size_t checked{4096};
+    std::vector<std::size_t> counts{};
+    std::vector<help::benchmark::result> results{};
+  };
+}
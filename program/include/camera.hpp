@@ -19,17 +19,8 @@ namespace cse::help::camera
     double far{1000.0};
   };
 
-  struct previous
+  struct state
   {
-  public:
-    previous() = default;
-    ~previous() = default;
-    previous(const previous &) = delete;
-    previous &operator=(const previous &) = delete;
-    previous(previous &&) = delete;
-    previous &operator=(previous &&) = delete;
-
-  public:
     temporal<glm::dvec3> translation{};
     temporal<glm::dvec3> forward{};
     temporal<glm::dvec3> up{};
@@ -41,7 +32,18 @@ namespace cse::help::camera
     help::phase phase{};
   };
 
-  struct active
+  struct previous : state
+  {
+  public:
+    previous() = default;
+    ~previous() = default;
+    previous(const previous &) = delete;
+    previous &operator=(const previous &) = delete;
+    previous(previous &&) = delete;
+    previous &operator=(previous &&) = delete;
+  };
+
+  struct active : state
   {
     friend class cse::scene;
     friend class cse::camera;
@@ -61,17 +63,6 @@ namespace cse::help::camera
 
     glm::dmat4 calculate_view_matrix(const previous &last, const double alpha) const;
     glm::dmat4 calculate_projection_matrix(const previous &last, const double aspect, const double alpha);
-
-  public:
-    temporal<glm::dvec3> translation{};
-    temporal<glm::dvec3> forward{};
-    temporal<glm::dvec3> up{};
-    temporal<double> fov{};
-    camera::clip clip{};
-
-    help::timer timer{};
-    help::mixer mixer{};
-    help::phase phase{};
   };
 }
 
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <span>
 #include <string_view>
+#include <vector>
 
 #include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
 
 #include "core.hpp"
 #include "macro.hpp"
@@ -18,8 +24,13 @@ namespace cse
   class collider
   {
   public:
+    static constexpr std::size_t capacity{256};
+    static constexpr std::size_t width{64};
+    using storage = std::array<std::uint64_t, capacity / width>;
+
     constexpr collider() = default;
     explicit constexpr collider(const std::uint64_t value_);
+    explicit constexpr collider(const storage &value_);
 
     constexpr bool operator==(const collider &other) const = default;
     constexpr collider operator|(const collider &other) const;
@@ -31,10 +42,12 @@ namespace cse
     constexpr collider &operator^=(const collider &other);
 
     constexpr bool empty() const;
+    constexpr bool intersects(const collider &other) const;
     constexpr std::uint64_t bits() const;
+    constexpr const storage &words() const;
 
   private:
-    std::uint64_t value{};
+    storage value{};
   };
 
   struct contact
@@ -54,6 +67,20 @@ namespace cse
     glm::dvec2 overlap{};
     glm::dvec2 normal{};
     glm::dvec2 penetration{};
+    double impact{1.0};
+  };
+  struct hit
+  {
+    object *pointer{};
+    cse::hitbox hitbox{};
+    double fraction{};
+  };
+  struct ray
+  {
+    glm::dvec2 start{};
+    glm::dvec2 end{};
+    double z{};
+    cse::collider mask{};
   };
 
   namespace help::collision
@@ -66,15 +93,80 @@ namespace cse
       std::int32_t top{};
       std::int32_t z{};
       std::uint32_t object{};
-      std::uint64_t layer{};
-      std::uint64_t target{};
+      std::uint32_t group{};
     };
-    struct slot
+    struct held
     {
+      auto operator<=>(const held &other) const = default;
+
+      std::uint32_t object{};
       std::uint32_t entry{};
+    };
+    struct area
+    {
+      struct hash
+      {
+        std::size_t operator()(const area &key) const;
+      };
+
+      bool operator==(const area &other) const = default;
+
+      std::int32_t z{};
       std::int32_t x{};
       std::int32_t y{};
-      std::int32_t bit{};
+      std::uint32_t group{};
+    };
+    struct group
+    {
+      cse::collider layer{};
+      cse::collider target{};
+      std::vector<std::uint32_t> matches{};
+      std::vector<std::uint32_t> partners{};
+    };
+    struct bucket
+    {
+      std::vector<held> members{};
+      std::vector<std::uint32_t> watchers{};
+    };
+    struct record
+    {
+      contact value{};
+      std::uint32_t self{};
+      std::uint32_t target{};
+    };
+    struct cache
+    {
+      glm::dvec3 translation{};
+      double rotation{};
+      glm::dvec2 scale{};
+      cse::flip flip{};
+      cse::animation animation{};
+      std::size_t frame{};
+      unsigned int width{};
+      unsigned int height{};
+      std::uint64_t revision{};
+      std::vector<cse::hitbox> boxes{};
+    };
+    inline std::atomic<std::uint64_t> revisions{};
+    struct body
+    {
+      std::uint64_t revision{};
+      cse::collider layer{};
+      cse::collider target{};
+      std::uint32_t group{};
+      bool continuous{};
+      glm::dvec3 origin{};
+      bool resting{};
+      bool settled{};
+      bool counted{};
+      bool dirty{true};
+      std::vector<entry> entries{};
+      std::vector<cse::hitbox> boxes{};
+      std::vector<cse::hitbox> origins{};
+      std::vector<area> stored{};
+      std::vector<area> watched{};
+      std::vector<area> observed{};
+      std::vector<record> records{};
     };
 
     struct store
@@ -97,11 +189,18 @@ namespace cse
     template <const auto &names> constexpr cse::collider every();
 
     std::int32_t quantize(const double value);
-    std::size_t cell(const std::int32_t z, const std::int32_t x, const std::int32_t y, const int bit);
+    std::size_t cell(const std::int32_t z, const std::int32_t x, const std::int32_t y, const std::uint32_t group);
     bool overlaps(const rectangle &first, const rectangle &second);
     bool overlaps(const cse::hitbox &first, const cse::hitbox &second);
     std::span<const cse::hitbox> hitboxes(const cse::object *object);
+    std::span<const cse::hitbox> world(const cse::object *object, cache &target);
     cse::hitbox bounds(const cse::object *object, const cse::hitbox &source);
+    cse::hitbox bounds(const cse::object *object, const cse::hitbox &source, const glm::dvec3 &translation,
+                       const double rotation, const glm::dvec2 &scale);
+    std::optional<double> sweep(const cse::hitbox &own_start, const cse::hitbox &own_end,
+                                const cse::hitbox &their_start, const cse::hitbox &their_end);
+    cse::hitbox blend(const cse::hitbox &start, const cse::hitbox &end, const double time);
+    std::optional<double> pierce(const glm::dvec2 &start, const glm::dvec2 &delta, const cse::hitbox &box);
     contact describe(const name self_name, cse::object *target, const cse::hitbox &own, const cse::hitbox &theirs);
     contact mirror(const contact &source, const name self_name, cse::object *target);
     cse::hitbox hit(const cse::interface *interface, const glm::dvec2 &point);
@@ -13,35 +13,73 @@ namespace cse
 {
   constexpr collider::collider(const std::uint64_t value_) : value{value_} {}
 
-  constexpr collider collider::operator|(const collider &other) const { return collider{value | other.value}; }
+  constexpr collider::collider(const storage &value_) : value{value_} {}
 
-  constexpr collider collider::operator&(const collider &other) const { return collider{value & other.value}; }
+  constexpr collider collider::operator|(const collider &other) const
+  {
+    auto result{*this};
+    return result |= other;
+  }
 
-  constexpr collider collider::operator^(const collider &other) const { return collider{value ^ other.value}; }
+  constexpr collider collider::operator&(const collider &other) const
+  {
+    auto result{*this};
+    return result &= other;
+  }
 
-  constexpr collider collider::operator~() const { return collider{~value}; }
+  constexpr collider collider::operator^(const collider &other) const
+  {
+    auto result{*this};
+    return result ^= other;
+  }
+
+  constexpr collider collider::operator~() const
+  {
+    auto result{*this};
+    for (auto &word : result.value) word = ~word;
+    return result;
+  }
 
   constexpr collider &collider::operator|=(const collider &other)
   {
-    value |= other.value;
+    for (std::size_t index{}; index < value.size(); ++index) value[index] |= other.value[index];
     return *this;
   }
 
   constexpr collider &collider::operator&=(const collider &other)
   {
-    value &= other.value;
+    for (std::size_t index{}; index < value.size(); ++index) value[index] &= other.value[index];
     return *this;
   }
 
   constexpr collider &collider::operator^=(const collider &other)
   {
-    value ^= other.value;
+    for (std::size_t index{}; index < value.size(); ++index) value[index] ^= other.value[index];
     return *this;
   }
 
-  constexpr bool collider::empty() const { return value == 0; }
+  constexpr bool collider::empty() const
+  {
+    std::uint64_t merged{};
+    for (const auto word : value) merged |= word;
+    return merged == 0;
+  }
+
+  constexpr bool collider::intersects(const collider &other) const
+  {
+    std::uint64_t merged{};
+    for (std::size_t index{}; index < value.size(); ++index) merged |= value[index] & other.value[index];
+    return merged != 0;
+  }
+
+  constexpr std::uint64_t collider::bits() const
+  {
+    for (std::size_t index{1}; index < value.size(); ++index)
+      if (value[index] != 0) throw std::out_of_range{"A collider above the first 64 names was read through bits()"};
+    return value.front();
+  }
 
-  constexpr std::uint64_t collider::bits() const { return value; }
+  constexpr auto collider::words() const -> const storage & { return value; }
 }
 
 namespace cse::help::collision
@@ -68,14 +106,19 @@ namespace cse::help::collision
   template <const auto &names> constexpr cse::collider forge(const std::string_view label)
   {
     static_assert(distinct(names), "COLLIDERS declares the same collider more than once");
-    static_assert(std::size(names) <= 64, "COLLIDERS declares more than 64 colliders");
-    return cse::collider{std::uint64_t{1} << position(names, label)};
+    static_assert(std::size(names) <= cse::collider::capacity, "COLLIDERS declares more than 256 colliders");
+    const auto index{position(names, label)};
+    cse::collider::storage value{};
+    value[index / cse::collider::width] = std::uint64_t{1} << (index % cse::collider::width);
+    return cse::collider{value};
   }
 
   template <const auto &names> constexpr cse::collider every()
   {
-    static_assert(std::size(names) <= 64, "COLLIDERS declares more than 64 colliders");
-    return cse::collider{std::size(names) == 64 ? ~std::uint64_t{}
-                                                : (std::uint64_t{1} << std::size(names)) - std::uint64_t{1}};
+    static_assert(std::size(names) <= cse::collider::capacity, "COLLIDERS declares more than 256 colliders");
+    cse::collider::storage value{};
+    for (std::size_t index{}; index < std::size(names); ++index)
+      value[index / cse::collider::width] |= std::uint64_t{1} << (index % cse::collider::width);
+    return cse::collider{value};
   }
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -23,18 +26,42 @@ namespace cse::help
 
   public:
     container() = default;
-    ~container() = default;
+    ~container();
     container(const container &other);
 
-    auto begin() const noexcept -> typename storage::const_iterator;
-    auto end() const noexcept -> typename storage::const_iterator;
-    std::size_t size() const noexcept;
-    bool empty() const noexcept;
+    auto begin() const -> typename storage::const_iterator;
+    auto end() const -> typename storage::const_iterator;
+    std::size_t size() const;
+    bool empty() const;
 
     const element &at(const std::size_t position) const;
     element operator[](const cse::name name) const;
-    element find(const cse::name name) const noexcept;
-    bool contains(const cse::name name) const noexcept;
+    element find(const cse::name name) const;
+    bool contains(const cse::name name) const;
+
+  private:
+    enum action : std::uint8_t
+    {
+      INSERTED,
+      REPLACED,
+      ERASED
+    };
+    struct change
+    {
+      action kind{};
+      std::size_t since{};
+      std::size_t position{};
+      element value{};
+    };
+    struct block
+    {
+      storage elements{};
+      std::unordered_map<cse::name, element> index{};
+      std::vector<change> journal{};
+      std::map<std::size_t, std::size_t> views{};
+      std::size_t version{};
+      std::mutex guard{};
+    };
 
   private:
     container &operator=(const container &other);
@@ -45,13 +72,15 @@ namespace cse::help
     bool remove(const cse::name name);
     void clear() noexcept;
 
-    void reindex() const;
-    const element *locate(const cse::name name) const noexcept;
+    const block *view() const;
+    block &own();
+    void record(block &target, change entry);
+    void release() const noexcept;
 
   private:
-    storage elements{};
-    mutable std::unordered_map<cse::name, std::size_t> index{};
-    mutable bool indexed{};
+    static inline const storage vacant{};
+    mutable std::shared_ptr<block> data{};
+    mutable std::size_t version{};
   };
 }
 
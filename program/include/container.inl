@@ -2,7 +2,11 @@
 
 #include "container.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <utility>
 
@@ -11,112 +15,184 @@
 
 namespace cse::help
 {
-  template <typename type> container<type>::container(const container &other) : elements{other.elements} {};
+  template <typename type> container<type>::~container() { release(); }
 
-  template <typename type> auto container<type>::begin() const noexcept -> typename storage::const_iterator
-  { return elements.begin(); }
+  template <typename type> container<type>::container(const container &other) : data{other.data}, version{other.version}
+  {
+    if (!data) return;
+    const std::scoped_lock lock{data->guard};
+    ++data->views[version];
+  }
 
-  template <typename type> auto container<type>::end() const noexcept -> typename storage::const_iterator
-  { return elements.end(); }
+  template <typename type> auto container<type>::begin() const -> typename storage::const_iterator
+  {
+    const auto *target{view()};
+    return target ? target->elements.begin() : vacant.begin();
+  }
 
-  template <typename type> std::size_t container<type>::size() const noexcept { return elements.size(); }
+  template <typename type> auto container<type>::end() const -> typename storage::const_iterator
+  {
+    const auto *target{view()};
+    return target ? target->elements.end() : vacant.end();
+  }
 
-  template <typename type> bool container<type>::empty() const noexcept { return elements.empty(); }
+  template <typename type> std::size_t container<type>::size() const
+  {
+    const auto *target{view()};
+    return target ? target->elements.size() : 0;
+  }
+
+  template <typename type> bool container<type>::empty() const { return size() == 0; }
 
   template <typename type>
   const typename container<type>::element &container<type>::at(const std::size_t position) const
-  { return elements.at(position); }
+  {
+    const auto *target{view()};
+    return (target ? target->elements : vacant).at(position);
+  }
 
   template <typename type> typename container<type>::element container<type>::operator[](const cse::name name) const
   {
-    const auto *value{locate(name)};
+    auto value{find(name)};
     if (!value) throw exception("Could not find element with name: {}", name.string());
-    return *value;
+    return value;
   }
 
-  template <typename type> typename container<type>::element container<type>::find(const cse::name name) const noexcept
+  template <typename type> typename container<type>::element container<type>::find(const cse::name name) const
   {
-    const auto *value{locate(name)};
-    if (!value) return nullptr;
-    return *value;
+    const auto *target{view()};
+    if (!target) return nullptr;
+    const auto iterator{target->index.find(name)};
+    if (iterator == target->index.end()) return nullptr;
+    return iterator->second;
   }
 
-  template <typename type> bool container<type>::contains(const cse::name name) const noexcept
-  { return locate(name) != nullptr; }
+  template <typename type> bool container<type>::contains(const cse::name name) const
+  {
+    const auto *target{view()};
+    return target && target->index.contains(name);
+  }
 
   template <typename type> container<type> &container<type>::operator=(const container &other)
   {
     if (this == &other) return *this;
-    elements = other.elements;
-    index.clear();
-    indexed = false;
+    release();
+    data = other.data;
+    version = other.version;
+    if (!data) return *this;
+    const std::scoped_lock lock{data->guard};
+    ++data->views[version];
     return *this;
   }
 
-  template <typename type> container<type>::container(container &&other) noexcept
-    : elements{std::move(other.elements)}, index{std::move(other.index)}, indexed{other.indexed}
-  {
-    other.index.clear();
-    other.indexed = false;
-  };
+  template <typename type>
+  container<type>::container(container &&other) noexcept
+    : data{std::move(other.data)}, version{std::exchange(other.version, 0)} {};
 
   template <typename type> container<type> &container<type>::operator=(container &&other) noexcept
   {
     if (this == &other) return *this;
-    elements = std::move(other.elements);
-    index = std::move(other.index);
-    indexed = other.indexed;
-    other.index.clear();
-    other.indexed = false;
+    release();
+    data = std::move(other.data);
+    version = std::exchange(other.version, 0);
     return *this;
   }
 
   template <typename type> void container<type>::set(const element &value)
   {
     if (!value) return;
-    if (!indexed) reindex();
-    if (const auto iterator{index.find(value->name)}; iterator != index.end())
+    auto &target{own()};
+    if (const auto iterator{target.index.find(value->name)}; iterator != target.index.end())
     {
-      elements.at(iterator->second) = value;
+      const auto found{std::ranges::find(target.elements, iterator->second)};
+      record(target, {REPLACED, 0, static_cast<std::size_t>(std::distance(target.elements.begin(), found)), *found});
+      *found = value;
+      iterator->second = value;
       return;
     }
-    elements.push_back(value);
-    index.insert_or_assign(value->name, elements.size() - 1);
+    record(target, {INSERTED, 0, target.elements.size(), nullptr});
+    target.elements.push_back(value);
+    target.index.emplace(value->name, value);
   }
 
   template <typename type> bool container<type>::remove(const cse::name name)
   {
-    if (!indexed) reindex();
-    const auto iterator{index.find(name)};
-    if (iterator == index.end()) return false;
-    elements.erase(elements.begin() + static_cast<std::ptrdiff_t>(iterator->second));
-    index.clear();
-    indexed = false;
+    if (!contains(name)) return false;
+    auto &target{own()};
+    const auto iterator{target.index.find(name)};
+    const auto found{std::ranges::find(target.elements, iterator->second)};
+    record(target, {ERASED, 0, static_cast<std::size_t>(std::distance(target.elements.begin(), found)), *found});
+    target.elements.erase(found);
+    target.index.erase(iterator);
     return true;
   }
 
-  template <typename type> void container<type>::clear() noexcept
+  template <typename type> void container<type>::clear() noexcept { release(); }
+
+  template <typename type> const typename container<type>::block *container<type>::view() const
   {
-    elements.clear();
-    index.clear();
-    indexed = true;
+    if (!data || version == data->version) return data.get();
+    const auto stale{data};
+    auto fresh{std::make_shared<block>()};
+    const std::scoped_lock lock{stale->guard};
+    fresh->elements = stale->elements;
+    for (auto entry{stale->journal.rbegin()}; entry != stale->journal.rend() && entry->since > version; ++entry)
+    {
+      const auto position{fresh->elements.begin() + static_cast<std::ptrdiff_t>(entry->position)};
+      switch (entry->kind)
+      {
+        case INSERTED: fresh->elements.erase(position); break;
+        case REPLACED: *position = entry->value; break;
+        case ERASED: fresh->elements.insert(position, entry->value); break;
+      }
+    }
+    for (const auto &value : fresh->elements) fresh->index.insert_or_assign(value->name, value);
+    fresh->views[0] = 1;
+    if (const auto found{stale->views.find(version)}; --found->second == 0) stale->views.erase(found);
+    data = std::move(fresh);
+    version = 0;
+    return data.get();
   }
 
-  template <typename type> void container<type>::reindex() const
+  template <typename type> typename container<type>::block &container<type>::own()
   {
-    index.clear();
-    index.reserve(elements.size());
-    for (std::size_t position{}; position < elements.size(); ++position)
-      if (const auto &value{elements.at(position)}) index.insert_or_assign(value->name, position);
-    indexed = true;
+    if (!data)
+    {
+      data = std::make_shared<block>();
+      version = 0;
+      data->views[0] = 1;
+    }
+    view();
+    return *data;
   }
 
-  template <typename type>
-  const typename container<type>::element *container<type>::locate(const cse::name name) const noexcept
+  template <typename type> void container<type>::record(block &target, change entry)
+  {
+    const std::scoped_lock lock{target.guard};
+    const auto mine{target.views.find(version)};
+    if (target.views.size() == 1 && mine->second == 1)
+    {
+      target.journal.clear();
+      return;
+    }
+    if (--mine->second == 0) target.views.erase(mine);
+    version = ++target.version;
+    ++target.views[version];
+    entry.since = version;
+    target.journal.push_back(std::move(entry));
+    const auto oldest{target.views.begin()->first};
+    target.journal.erase(target.journal.begin(), std::ranges::find_if(target.journal, [oldest](const change &kept)
+                                                                      { return kept.since > oldest; }));
+  }
+
+  template <typename type> void container<type>::release() const noexcept
   {
-    if (!indexed) reindex();
-    const auto iterator{index.find(name)};
-    if (iterator == index.end()) return nullptr;
-    return &elements.at(iterator->second);
+    if (!data) return;
+    {
+      const std::scoped_lock lock{data->guard};
+      if (const auto found{data->views.find(version)}; found != data->views.end() && --found->second == 0)
+        data->views.erase(found);
+    }
+    data.reset();
   }
 }
@@ -26,6 +26,8 @@ namespace cse::help
     CREATED
   };
 
+  class harness;
+
   namespace game
   {
     struct previous;
@@ -63,6 +65,10 @@ namespace cse::help
     struct previous;
     struct active;
   }
+  namespace transform
+  {
+    struct store;
+  }
 }
 
 namespace cse::trait
@@ -25,11 +25,14 @@
 #include "container.hpp"
 #include "core.hpp"
 #include "function.hpp"
+#include "histogram.hpp"
 #include "mixer.hpp"
 #include "name.hpp"
 #include "resource.hpp"
 #include "temporal.hpp"
 #include "timer.hpp"
+#include "transform.hpp"
+#include "worker.hpp"
 
 enum scaling : std::uint8_t
 {
@@ -44,12 +47,32 @@ namespace cse::help::game
     double target{};
     unsigned int count{};
     double average{};
+    double jitter{};
   };
   struct frame
   {
     double target{};
     unsigned int count{};
     double average{};
+    double jitter{};
+  };
+  struct latency
+  {
+    double p50{};
+    double p95{};
+    double p99{};
+    double maximum{};
+  };
+  struct timing
+  {
+    game::latency synchronize{};
+    game::latency event{};
+    game::latency simulate{};
+    game::latency collide{};
+    game::latency prepare{};
+    game::latency upload{};
+    game::latency submit{};
+    game::latency mix{};
   };
   struct aspect
   {
@@ -67,6 +90,12 @@ namespace cse::help::game
     std::size_t current{};
     std::size_t maximum{};
   };
+  struct headless
+  {
+    bool enabled{};
+    bool render{};
+    bool unthrottled{};
+  };
   struct memory
   {
     struct initial
@@ -91,6 +120,7 @@ namespace cse::help::game
   public:
     game::tick tick{};
     game::frame frame{};
+    game::timing timing{};
     game::aspect aspect{};
     temporal<glm::dvec3> clear{};
     game::memory memory{};
@@ -112,6 +142,8 @@ namespace cse::help::game
   struct active
   {
     friend class cse::game;
+    friend class cse::scene;
+    friend class help::harness;
     friend struct window::active;
     friend struct scene::active;
 
@@ -122,6 +154,31 @@ namespace cse::help::game
       std::size_t bytes{};
       double stamp{};
     };
+    struct meter
+    {
+      std::optional<double> start{};
+      std::optional<double> deadline{};
+      double accumulator{};
+      unsigned int count{};
+    };
+    struct spread
+    {
+      std::optional<double> last{};
+      double sum{};
+      double squares{};
+      unsigned int count{};
+    };
+    struct profile
+    {
+      help::histogram synchronize{};
+      help::histogram event{};
+      help::histogram simulate{};
+      help::histogram collide{};
+      help::histogram prepare{};
+      help::histogram upload{};
+      help::histogram submit{};
+      help::histogram mix{};
+    };
     struct pair_hash
     {
       template <typename first, typename second>
@@ -213,12 +270,18 @@ namespace cse::help::game
       };
       struct sample
       {
-        std::array<float, 16> model{};
-        float red{}, green{}, blue{}, alpha{};
-        float left{}, bottom{}, right{}, top{};
-        float lit{}, shadowed{}, brightness{}, transparency{};
+        float x{}, y{}, z{};
+        std::int16_t width{}, height{};
+        std::array<std::uint8_t, 4> color{};
+        std::array<std::uint16_t, 4> frame{};
         float depth{};
-        float occluder{-1.0f};
+        float brightness{};
+        std::uint32_t flags{};
+      };
+      struct target
+      {
+        SDL_GPUGraphicsPipeline *pipeline{};
+        SDL_GPUTexture *texture{};
       };
       std::vector<batch> batches{};
       std::vector<sample> samples{};
@@ -226,6 +289,11 @@ namespace cse::help::game
       std::vector<char> shown{};
       std::vector<char> lettered{};
       std::vector<std::size_t> emission_order{};
+      std::vector<std::uint64_t> keys{};
+      std::vector<std::uint64_t> scratch{};
+      std::vector<target> targets{};
+      std::vector<std::size_t> offsets{};
+      std::unordered_map<SDL_GPUTexture *, std::uint32_t> textures{};
       std::size_t split{};
       std::pair<glm::dmat4, glm::dmat4> world{};
       std::pair<glm::dmat4, glm::dmat4> overlay{};
@@ -252,7 +320,7 @@ namespace cse::help::game
       };
       struct quad
       {
-        std::array<float, 16> model{};
+        help::transform::placement placement{};
         float left{}, bottom{}, right{}, top{};
         double minimum_x{}, minimum_y{}, maximum_x{}, maximum_y{};
         float occluder{-1.0f};
@@ -314,7 +382,8 @@ namespace cse::help::game
     active() = default;
     active(const double tick_, const double frame_, const game::aspect &aspect_, const temporal<glm::dvec3> &clear_,
            const game::memory::initial &memory_, const std::string &language_, const temporal<double> &master_,
-           const temporal<double> &sound_, const temporal<double> &music_);
+           const temporal<double> &sound_, const temporal<double> &music_, const bool pace_,
+           const game::headless &headless_);
     ~active() = default;
     active(const active &) = delete;
     active &operator=(const active &) = delete;
@@ -326,6 +395,7 @@ namespace cse::help::game
     void create();
     void synchronize(previous &last);
     void render();
+    void upload();
     void mix(const help::mixer &previous_mixer, const temporal<double> previous_master,
              const temporal<double> previous_sound, const temporal<double> previous_music);
     void destroy();
@@ -339,13 +409,14 @@ namespace cse::help::game
 
     void generate_graphics_order();
     void generate_frustum();
-    void generate_text(const std::vector<cse::object *> &object_order);
+    void generate_text(const std::vector<cse::object *> &object_order, const help::transform::store &transforms);
     void generate_lights(const std::vector<cse::light *> &light_order);
-    void generate_occluders(const std::vector<cse::object *> &object_order);
-    void generate_objects(const std::vector<cse::object *> &object_order);
+    void generate_occluders(const std::vector<cse::object *> &object_order, const help::transform::store &transforms);
+    void generate_objects(const std::vector<cse::object *> &object_order, const help::transform::store &transforms);
     void generate_interfaces();
     bool inside_frustum(const glm::dvec3 &center, const double radius) const;
     static bool usable(const cse::image &image);
+    static void place(graphics_object::sample &data, const help::transform::placement &placement);
     template <typename type> void compose_text(type &text, const type &last, const cse::name &element,
                                                const double box_left, const double box_right, const double box_top,
                                                const double box_bottom, std::vector<graphics_text::composed> &output);
@@ -361,6 +432,7 @@ namespace cse::help::game
   public:
     game::tick tick{};
     game::frame frame{};
+    game::timing timing{};
     game::aspect aspect{};
     temporal<glm::dvec3> clear{};
     game::memory memory{};
@@ -381,16 +453,28 @@ namespace cse::help::game
   private:
     double actual_tick{1.0 / tick.target};
     double time{};
+    std::optional<double> simulation_time{};
     double accumulator{};
     double alpha{};
+    bool pace{};
+    unsigned int tick_batch{};
+    active::spread tick_spread{};
+    active::meter tick_meter{};
+    active::profile profile{};
     std::unordered_set<cse::name> interface_removals{};
     help::container<cse::interface> interface_additions{};
     std::vector<cse::interface *> interface_order{};
     std::vector<cse::interface *> interface_pool{};
+    help::worker worker{};
+    static constexpr std::size_t sample_grain{256};
 
+    game::headless headless{};
     static constexpr auto gpu_backend{"vulkan"};
     static constexpr auto shader_format{SDL_GPU_SHADERFORMAT_SPIRV};
     double actual_frame{1.0 / frame.target};
+    double frame_deadline{};
+    active::spread frame_spread{};
+    active::meter frame_meter{};
     game::vram actual_vram{};
     game::ram actual_ram{};
     SDL_GPUDevice *video{};
@@ -443,6 +527,8 @@ namespace cse
       const temporal<double> master{0.5};
       const temporal<double> sound{0.5};
       const temporal<double> music{0.5};
+      const bool pace{};
+      const help::game::headless headless{};
     };
 
   public:
@@ -521,14 +607,19 @@ namespace cse
     void clean();
 
     void time();
+    static double clock();
     void step();
 
     bool running() const;
     bool behind();
     bool ready();
+    void pace();
 
     void tps();
     void fps();
+    static help::game::latency measure(const help::histogram &histogram);
+    static void sample(help::game::active::spread &spread, const double now, const unsigned int steps);
+    static double deviation(help::game::active::spread &spread);
 
   public:
     help::game::previous previous{};
@@ -296,7 +296,7 @@ namespace cse::help::game
                                                             help::mixer *active_mixer, const char *tag,
                                                             const bool predecode, const double bus)
   {
-    if (!previous_mixer) return;
+    if (!previous_mixer || active_mixer->count<resource>() == 0) return;
     auto &entries{active_mixer->select<resource>()};
     const auto *previous_entries{previous_mixer ? &previous_mixer->select<resource>() : nullptr};
     for (auto &[entry_name, entry] : entries)
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core.hpp"
+
+namespace cse::help
+{
+  class harness
+  {
+  public:
+    struct occupancy
+    {
+      std::int32_t shift{};
+      std::size_t entries{};
+      std::size_t cells{};
+      std::size_t members{};
+      std::size_t slots{};
+      std::size_t buckets{};
+    };
+
+  public:
+    static void prepare(cse::scene &scene);
+    static void create(cse::scene &scene);
+    static void synchronize(cse::scene &scene);
+    static void simulate(cse::scene &scene, const double tick);
+    static void destroy(cse::scene &scene);
+    static void clean(cse::scene &scene);
+
+    static double tick(const cse::game &game);
+    static void blend(cse::game &game, const double alpha);
+    static std::shared_ptr<cse::scene> attach(cse::game &game, std::shared_ptr<cse::scene> scene);
+    static void render(cse::scene &scene, cse::game &game);
+    static void order(cse::scene &scene);
+    static void contacts(cse::scene &scene, cse::game &game);
+    static void graphics(cse::scene &scene, const cse::game &game);
+    static void sequence(cse::game &game);
+    static void pool(cse::game &game);
+    static void layers(cse::game &game);
+    static void frustum(cse::game &game);
+    static void text(cse::game &game, const cse::scene &scene);
+    static void lights(cse::game &game, const cse::scene &scene);
+    static void occluders(cse::game &game, const cse::scene &scene);
+    static void objects(cse::game &game, const cse::scene &scene);
+    static void interfaces(cse::game &game);
+    static occupancy measure(const cse::scene &scene);
+  };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cse::help
+{
+  class histogram
+  {
+  public:
+    static constexpr std::size_t divisions{8};
+    static constexpr std::size_t buckets{divisions * 24};
+    static constexpr double origin{1e-6};
+
+  public:
+    void record(const double seconds) noexcept;
+    double percentile(const double fraction) const noexcept;
+    double maximum() const noexcept;
+    std::uint64_t count() const noexcept;
+    void clear() noexcept;
+
+  private:
+    static std::size_t bucket(const double seconds) noexcept;
+    static double edge(const std::size_t index) noexcept;
+
+  private:
+    std::array<std::uint64_t, buckets> counts{};
+    std::uint64_t total{};
+    double peak{};
+  };
+}
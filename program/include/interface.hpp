@@ -5,7 +5,6 @@
 
 #include "SDL3/SDL_events.h"
 #include "SDL3/SDL_mouse.h"
-#include "glm/ext/matrix_double4x4.hpp"
 #include "glm/ext/vector_double2.hpp"
 
 #include "core.hpp"
@@ -15,6 +14,7 @@
 #include "resource.hpp"
 #include "temporal.hpp"
 #include "timer.hpp"
+#include "transform.hpp"
 
 namespace cse::help::interface
 {
@@ -48,17 +48,8 @@ namespace cse::help::interface
     std::array<cse::hitbox, SDL_BUTTON_X2 + 1> clicked{};
   };
 
-  struct previous
+  struct state
   {
-  public:
-    previous() = default;
-    ~previous() = default;
-    previous(const previous &) = delete;
-    previous &operator=(const previous &) = delete;
-    previous(previous &&) = delete;
-    previous &operator=(previous &&) = delete;
-
-  public:
     temporal<glm::dvec2> translation{};
     temporal<double> rotation{};
     temporal<glm::dvec2> scale{};
@@ -73,7 +64,18 @@ namespace cse::help::interface
     help::phase phase{};
   };
 
-  struct active
+  struct previous : state
+  {
+  public:
+    previous() = default;
+    ~previous() = default;
+    previous(const previous &) = delete;
+    previous &operator=(const previous &) = delete;
+    previous(previous &&) = delete;
+    previous &operator=(previous &&) = delete;
+  };
+
+  struct active : state
   {
     friend class cse::game;
     friend class cse::scene;
@@ -94,26 +96,12 @@ namespace cse::help::interface
   private:
     void synchronize(previous &last);
 
-    glm::dmat4 calculate_model_matrix(const previous &last, const unsigned int frame_width,
-                                      const unsigned int frame_height, const glm::dvec2 &pivot,
-                                      const double alpha) const;
-    glm::dmat4 calculate_text_matrix(const previous &last, const double width, const double height,
-                                     const glm::dvec2 &offset, const double alpha) const;
+    transform::placement calculate_model_placement(const previous &last, const unsigned int frame_width,
+                                                   const unsigned int frame_height, const glm::dvec2 &pivot,
+                                                   const double alpha) const;
+    transform::placement calculate_text_placement(const previous &last, const double width, const double height,
+                                                  const glm::dvec2 &offset, const double alpha) const;
     void animate(const double tick);
-
-  public:
-    temporal<glm::dvec2> translation{};
-    temporal<double> rotation{};
-    temporal<glm::dvec2> scale{};
-    bool interactable{};
-    interface::texture texture{};
-    interface::text text{};
-    interface::priority priority{};
-
-    interface::target target{};
-    help::timer timer{};
-    help::mixer mixer{};
-    help::phase phase{};
   };
 }
 
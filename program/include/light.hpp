@@ -33,17 +33,8 @@ namespace cse::help::light
     temporal<double> softness{};
   };
 
-  struct previous
+  struct state
   {
-  public:
-    previous() = default;
-    ~previous() = default;
-    previous(const previous &) = delete;
-    previous &operator=(const previous &) = delete;
-    previous(previous &&) = delete;
-    previous &operator=(previous &&) = delete;
-
-  public:
     temporal<glm::dvec3> translation{};
     temporal<glm::dvec2> rotation{};
     light::illumination illumination{};
@@ -55,7 +46,18 @@ namespace cse::help::light
     help::phase phase{};
   };
 
-  struct active
+  struct previous : state
+  {
+  public:
+    previous() = default;
+    ~previous() = default;
+    previous(const previous &) = delete;
+    previous &operator=(const previous &) = delete;
+    previous(previous &&) = delete;
+    previous &operator=(previous &&) = delete;
+  };
+
+  struct active : state
   {
     friend class cse::scene;
     friend class cse::light;
@@ -76,17 +78,6 @@ namespace cse::help::light
     void synchronize(previous &last);
 
     glm::dvec3 calculate_direction(const previous &last, const double alpha) const;
-
-  public:
-    temporal<glm::dvec3> translation{};
-    temporal<glm::dvec2> rotation{};
-    light::illumination illumination{};
-    light::shadow shadow{};
-    int priority{};
-
-    help::timer timer{};
-    help::mixer mixer{};
-    help::phase phase{};
   };
 }
 
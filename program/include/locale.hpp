@@ -102,7 +102,7 @@ namespace cse
     lexeme(const std::initializer_list<help::locale::store::segment> segments);
     ~lexeme() = default;
     lexeme(const lexeme &) = default;
-    lexeme &operator=(const lexeme &) = default;
+    lexeme &operator=(const lexeme &other);
     lexeme(lexeme &&) = default;
     lexeme &operator=(lexeme &&) = default;
 
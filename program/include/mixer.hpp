@@ -74,6 +74,7 @@ namespace cse::help
 
   private:
     void simulate(const double tick);
+    void settle() noexcept;
 
     template <trait::is_audio audio> auto &select() noexcept;
     template <trait::is_audio audio> const auto &select() const noexcept;
@@ -81,6 +82,7 @@ namespace cse::help
   private:
     std::unordered_map<name, entry<cse::sound>> sounds{};
     std::unordered_map<name, entry<cse::music>> musics{};
+    std::size_t revision{};
   };
 }
 
@@ -81,6 +81,7 @@ namespace cse::help
   template <trait::is_audio audio> auto &mixer::select() noexcept
   {
     static_assert(std::is_same_v<audio, cse::sound> || std::is_same_v<audio, cse::music>, "Invalid audio type");
+    ++revision;
     if constexpr (std::is_same_v<audio, cse::sound>)
       return sounds;
     else
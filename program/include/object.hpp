@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+
 #include "SDL3/SDL_events.h"
-#include "glm/ext/matrix_double4x4.hpp"
 #include "glm/ext/vector_double2.hpp"
 #include "glm/ext/vector_double3.hpp"
 
@@ -13,6 +15,7 @@
 #include "resource.hpp"
 #include "temporal.hpp"
 #include "timer.hpp"
+#include "transform.hpp"
 
 namespace cse::help::object
 {
@@ -20,6 +23,8 @@ namespace cse::help::object
   {
     cse::collider self{};
     cse::collider target{};
+    bool continuous{};
+    bool fixed{};
   };
   struct illumination
   {
@@ -59,19 +64,11 @@ namespace cse::help::object
   {
     int simulation{};
     int rendering{};
+    bool parallel{};
   };
 
-  struct previous
+  struct state
   {
-  public:
-    previous() = default;
-    ~previous() = default;
-    previous(const previous &) = delete;
-    previous &operator=(const previous &) = delete;
-    previous(previous &&) = delete;
-    previous &operator=(previous &&) = delete;
-
-  public:
     temporal<glm::dvec3> translation{};
     temporal<double> rotation{};
     temporal<glm::dvec2> scale{};
@@ -85,7 +82,18 @@ namespace cse::help::object
     help::phase phase{};
   };
 
-  struct active
+  struct previous : state
+  {
+  public:
+    previous() = default;
+    ~previous() = default;
+    previous(const previous &) = delete;
+    previous &operator=(const previous &) = delete;
+    previous(previous &&) = delete;
+    previous &operator=(previous &&) = delete;
+  };
+
+  struct active : state
   {
     friend class cse::scene;
     friend class cse::object;
@@ -105,25 +113,13 @@ namespace cse::help::object
   private:
     void synchronize(previous &last);
 
-    glm::dmat4 calculate_model_matrix(const previous &last, const unsigned int frame_width,
-                                      const unsigned int frame_height, const glm::dvec2 &pivot,
-                                      const double alpha) const;
-    glm::dmat4 calculate_text_matrix(const previous &last, const double width, const double height,
-                                     const glm::dvec2 &offset, const double alpha) const;
+    transform::placement calculate_model_placement(const glm::dvec3 &translation_, const double rotation_,
+                                                   const glm::dvec2 &scale_, const unsigned int frame_width,
+                                                   const unsigned int frame_height, const glm::dvec2 &pivot) const;
+    transform::placement calculate_text_placement(const glm::dvec3 &translation_, const double rotation_,
+                                                  const double width, const double height,
+                                                  const glm::dvec2 &offset) const;
     void animate(const double tick);
-
-  public:
-    temporal<glm::dvec3> translation{};
-    temporal<double> rotation{};
-    temporal<glm::dvec2> scale{};
-    object::collider collider{};
-    object::texture texture{};
-    object::text text{};
-    object::priority priority{};
-
-    help::timer timer{};
-    help::mixer mixer{};
-    help::phase phase{};
   };
 }
 
@@ -132,6 +128,9 @@ namespace cse
   class object
   {
     friend class scene;
+    friend struct help::game::active;
+    friend struct help::scene::active;
+    friend struct help::transform::store;
 
   protected:
     struct initial
@@ -152,6 +151,8 @@ namespace cse
     object(object &&) = delete;
     object &operator=(object &&) = delete;
 
+    std::span<const cse::hitbox> hitboxes() const;
+
   protected:
     explicit object(const initial &initial_);
     virtual void on_prepare();
@@ -179,5 +180,9 @@ namespace cse
     cse::identity name{};
     help::object::previous previous{};
     help::object::active active{};
+
+  private:
+    std::size_t slot{};
+    mutable help::collision::cache bounds{};
   };
 }
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace cse::help
+{
+  void radix_sort(std::vector<std::uint64_t> &keys, std::vector<std::uint64_t> &scratch);
+}
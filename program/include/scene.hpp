@@ -1,15 +1,19 @@
 #pragma once
 
+#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "SDL3/SDL_events.h"
+#include "glm/ext/vector_double2.hpp"
 
 #include "collision.hpp"
 #include "container.hpp"
@@ -18,6 +22,8 @@
 #include "name.hpp"
 #include "resource.hpp"
 #include "timer.hpp"
+#include "transform.hpp"
+#include "worker.hpp"
 
 namespace cse::help::scene
 {
@@ -37,6 +43,9 @@ namespace cse::help::scene
     help::container<cse::object> objects{};
     help::container<cse::light> lights{};
     std::vector<contact> contacts{};
+    std::vector<contact> began{};
+    std::vector<contact> persisted{};
+    std::vector<contact> ended{};
     help::timer timer{};
     help::mixer mixer{};
     help::phase phase{};
@@ -46,6 +55,7 @@ namespace cse::help::scene
   {
     friend class cse::game;
     friend class cse::scene;
+    friend class help::harness;
     friend struct game::active;
 
   private:
@@ -58,11 +68,20 @@ namespace cse::help::scene
 
       bool operator==(const contact_key &other) const = default;
 
-      std::size_t self;
-      std::size_t target;
+      std::uint64_t self;
+      std::uint64_t target;
       std::uint64_t self_hitbox;
       std::uint64_t target_hitbox;
     };
+    struct draw_key
+    {
+      auto operator<=>(const draw_key &other) const = default;
+
+      std::int64_t depth;
+      int priority;
+      std::uintptr_t batch;
+      std::uint64_t name;
+    };
 
   public:
     active() = default;
@@ -77,7 +96,8 @@ namespace cse::help::scene
     void render(game::active &game_active, const double aspect, const double alpha);
 
     void generate_simulation_order();
-    void generate_contacts();
+    void generate_contacts(help::worker &worker, const previous &last);
+    void generate_changes(const previous &last);
 
     void generate_graphics_order(const double alpha);
 
@@ -87,11 +107,20 @@ namespace cse::help::scene
     help::container<cse::object> objects{};
     help::container<cse::light> lights{};
     std::vector<contact> contacts{};
+    std::vector<contact> began{};
+    std::vector<contact> persisted{};
+    std::vector<contact> ended{};
     help::timer timer{};
     help::mixer mixer{};
     help::phase phase{};
 
   private:
+    static constexpr std::size_t contact_grain{64};
+    static constexpr std::size_t contact_floor{1024};
+    static constexpr double cell_ratio{2.6};
+    static constexpr double depth_step{1e-4};
+    static constexpr std::size_t repair_factor{4};
+    static constexpr std::size_t repair_slack{64};
     std::unordered_set<cse::name> interface_removals{};
     help::container<cse::interface> interface_additions{};
     std::vector<cse::interface *> interface_simulation_order{};
@@ -104,13 +133,34 @@ namespace cse::help::scene
 
     std::vector<cse::object *> object_graphics_order{};
     std::vector<cse::light *> light_graphics_order{};
+    help::transform::store transforms{};
+    std::vector<draw_key> object_keys{};
+    std::vector<cse::object *> object_members{};
 
-    std::vector<collision::entry> contact_entries{};
-    std::vector<cse::hitbox> contact_hitboxes{};
-    std::vector<std::uint32_t> contact_counts{};
-    std::vector<std::uint32_t> contact_cursor{};
-    std::vector<collision::slot> contact_table{};
+    std::vector<cse::object *> contact_members{};
+    std::vector<collision::body> contact_bodies{};
+    std::unordered_map<collision::area, collision::bucket, collision::area::hash> contact_grid{};
+    std::unordered_map<collision::area, collision::bucket, collision::area::hash> contact_fixed{};
+    std::vector<collision::group> contact_groups{};
+    cse::collider contact_layers{};
+    cse::collider contact_targets{};
+    std::int32_t contact_shift{-1};
+    std::size_t contact_limit{contact_floor};
+    std::int64_t contact_extents{};
+    std::size_t contact_count{};
+    std::int64_t contact_spread{};
+    std::size_t contact_total{};
+    std::vector<std::uint32_t> contact_moved{};
+    std::vector<std::uint32_t> contact_dirty{};
     std::unordered_map<contact_key, std::size_t, contact_key::hash> contact_lookup{};
+    std::vector<contact_key> contact_keys{};
+    std::unordered_map<contact_key, std::size_t, contact_key::hash> contact_lookup_previous{};
+    std::vector<contact_key> contact_keys_previous{};
+    std::vector<std::uint32_t> contact_owners{};
+    std::vector<std::uint32_t> contact_offsets{};
+    std::vector<std::uint32_t> contact_cursor{};
+    std::vector<std::uint32_t> contact_positions{};
+    bool contact_carried{};
   };
 
   struct next
@@ -125,6 +175,7 @@ namespace cse
   class scene
   {
     friend class game;
+    friend class help::harness;
 
   protected:
     struct initial
@@ -152,6 +203,13 @@ namespace cse
                  trait::is_interface<target_types>) &&
                 ...))
     void remove(const cse::name target_name);
+    std::vector<hit> overlapping(const rectangle &area, const double z, const collider mask) const;
+    std::vector<hit> under(const glm::dvec2 &point, const double z, const collider mask) const;
+    std::vector<contact> touching(const cse::name object_name) const;
+    std::vector<hit> cast(const ray &segment) const;
+    std::optional<hit> first(const ray &segment) const;
+    std::vector<std::vector<hit>> cast(const std::span<const ray> segments) const;
+    std::vector<std::optional<hit>> first(const std::span<const ray> segments) const;
 
   protected:
     explicit scene() = default;
@@ -184,6 +242,8 @@ namespace cse
     void render(const double aspect, const double alpha);
     void destroy();
     void clean();
+    void march(const ray &segment, const bool nearest,
+               std::vector<std::pair<double, help::collision::held>> &found) const;
 
   public:
     cse::game *game{};
@@ -17,4 +17,9 @@ namespace cse
   };
 }
 
+namespace cse::help
+{
+  template <typename... types> void settle(temporal<types> &...targets) noexcept;
+}
+
 #include "temporal.inl" // IWYU pragma: keep
@@ -10,3 +10,8 @@ namespace cse
     return previous.value + ((value - previous.value) * alpha);
   }
 }
+
+namespace cse::help
+{
+  template <typename... types> void settle(temporal<types> &...targets) noexcept { ((targets.instant = false), ...); }
+}
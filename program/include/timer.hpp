@@ -74,6 +74,7 @@ namespace cse::help
 
   private:
     std::unordered_map<name, entry> entries{};
+    std::size_t revision{};
   };
 }
 
@@ -26,6 +26,7 @@ namespace cse::help
 
   template <typename signature> timer::state &timer::set(const name name, const std::function<signature> &callback)
   {
+    ++revision;
     return entries
       .insert_or_assign(name, entry{std::make_shared<const std::any>(callback), std::type_index(typeid(signature)), {}})
       .first->second.state;
@@ -39,6 +40,7 @@ namespace cse::help
 
   template <typename callable> void timer::iterate(callable &&function)
   {
+    ++revision;
     std::vector<name> names{};
     names.reserve(entries.size());
     for (const auto &[name, target] : entries) names.push_back(name);
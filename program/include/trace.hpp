@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "macro.hpp"
+
+#if defined(CSE_TRACE)
+  #define CSE_TRACE_ZONE(label) const cse::help::trace::zone CSE_JOIN(trace_zone_, __LINE__)(label)
+#else
+  #define CSE_TRACE_ZONE(label)
+#endif
+
+namespace cse::help::trace
+{
+#if defined(CSE_TRACE)
+  class ring
+  {
+  public:
+    struct event
+    {
+      std::atomic<std::uint64_t> sequence{};
+      std::atomic<const char *> label{};
+      std::atomic<std::uint64_t> begin{};
+      std::atomic<std::uint64_t> end{};
+    };
+    struct sample
+    {
+      const char *label{};
+      std::uint64_t begin{};
+      std::uint64_t end{};
+    };
+
+  public:
+    static constexpr std::size_t capacity{std::size_t{1} << 15};
+
+  public:
+    explicit ring(const std::uint32_t thread_);
+    ~ring() = default;
+    ring(const ring &) = delete;
+    ring &operator=(const ring &) = delete;
+    ring(ring &&) = delete;
+    ring &operator=(ring &&) = delete;
+
+    void push(const char *label, const std::uint64_t begin, const std::uint64_t end) noexcept;
+    template <typename callable> void iterate(callable &&function) const;
+    std::uint32_t thread() const noexcept;
+
+  private:
+    std::array<event, capacity> events{};
+    std::atomic<std::uint64_t> head{};
+    std::uint32_t identifier{};
+  };
+
+  class zone
+  {
+  public:
+    explicit zone(const char *label_) noexcept;
+    ~zone();
+    zone(const zone &) = delete;
+    zone &operator=(const zone &) = delete;
+    zone(zone &&) = delete;
+    zone &operator=(zone &&) = delete;
+
+  private:
+    const char *label{};
+    std::uint64_t begin{};
+  };
+
+  inline std::mutex registry_mutex{};
+  inline std::vector<std::unique_ptr<ring>> registry{};
+
+  ring &local();
+  bool flush();
+#else
+  inline bool flush() { return false; }
+#endif
+}
+
+#if defined(CSE_TRACE)
+  #include "trace.inl" // IWYU pragma: keep
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "trace.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace cse::help::trace
+{
+  template <typename callable> void ring::iterate(callable &&function) const
+  {
+    const auto last{head.load(std::memory_order_acquire)};
+    const auto first{last > capacity ? last - capacity : 0};
+    for (auto index{first}; index < last; ++index)
+    {
+      const auto &slot{events.at(index & (capacity - 1))};
+      if (slot.sequence.load(std::memory_order_acquire) != index + 1) continue;
+      const sample copy{slot.label.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                        slot.end.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != index + 1) continue;
+      std::forward<callable>(function)(copy);
+    }
+  }
+}
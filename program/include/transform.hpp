@@ -1,18 +1,41 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
 
+#include "container.hpp"
+#include "core.hpp"
 #include "numeric.hpp"
 #include "resource.hpp"
 
 namespace cse::help::transform
 {
+  struct placement
+  {
+    glm::dvec3 center{};
+    glm::dvec2 size{};
+    int steps{};
+  };
+
   glm::dvec2 rotate(const glm::dvec2 &value, const int steps);
   glm::dvec2 unrotate(const glm::dvec2 &value, const int steps);
   cse::rectangle turn(const cse::rectangle &value, const int steps);
   glm::dvec2 grid(const double extent_x, const double extent_y);
   glm::dvec2 anchor(const int steps, const cse::flip &flip, const double scale_x, const double scale_y,
                     const unsigned int frame_width, const unsigned int frame_height, const glm::dvec2 &pivot);
+  placement place(const glm::dvec3 &translation, const int steps, const glm::dvec2 &offset, const glm::dvec2 &size);
   double snap_x(const double center, const double size);
   double snap_y(const double center, const double size);
+
+  struct store
+  {
+    void gather(const help::container<cse::object> &objects, const double alpha);
+
+    std::vector<glm::dvec3> translation{};
+    std::vector<double> rotation{};
+    std::vector<glm::dvec2> scale{};
+  };
 }
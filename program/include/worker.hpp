@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cse::help
+{
+  class worker
+  {
+  public:
+    using job = std::function<void(const std::size_t)>;
+
+  public:
+    worker() = default;
+    ~worker();
+    worker(const worker &) = delete;
+    worker &operator=(const worker &) = delete;
+    worker(worker &&) = delete;
+    worker &operator=(worker &&) = delete;
+
+    void start(const std::size_t count);
+    void stop();
+    std::size_t size() const noexcept;
+    void run(const std::size_t count, const job &function);
+
+  private:
+    void loop();
+    void drain();
+
+  private:
+    std::vector<std::thread> threads{};
+    std::mutex claim{};
+    std::mutex mutex{};
+    std::condition_variable wake{};
+    std::condition_variable done{};
+    const job *current{};
+    std::atomic<std::size_t> cursor{};
+    std::size_t total{};
+    std::size_t busy{};
+    std::uint64_t generation{};
+    std::exception_ptr failure{};
+    bool stopping{};
+  };
+}
@@ -17,33 +17,14 @@ namespace cse::help::camera
 {
   active::active(const temporal<glm::dvec3> &translation_, const temporal<glm::dvec3> &forward_,
                  const temporal<glm::dvec3> &up_, const temporal<double> &fov_, const camera::clip &clip_)
-    : translation{translation_}, forward{forward_}, up{up_}, fov{fov_}, clip{clip_} {};
+    : state{.translation = translation_, .forward = forward_, .up = up_, .fov = fov_, .clip = clip_} {};
 
   void active::synchronize(previous &last)
   {
-    last.translation = translation;
-    last.forward = forward;
-    last.up = up;
-    last.fov = fov;
-    last.clip = clip;
-    last.timer = timer;
-    last.mixer = mixer;
-    last.phase = phase;
-
-    for (auto &[name, sound] : mixer.sounds)
-    {
-      sound.speed.instant = false;
-      sound.volume.instant = false;
-    }
-    for (auto &[name, music] : mixer.musics)
-    {
-      music.speed.instant = false;
-      music.volume.instant = false;
-    }
-    translation.instant = false;
-    forward.instant = false;
-    up.instant = false;
-    fov.instant = false;
+    static_cast<state &>(last) = *this;
+
+    mixer.settle();
+    help::settle(translation, forward, up, fov);
   }
 
   glm::dmat4 active::calculate_view_matrix(const previous &last, const double alpha) const
@@ -4,11 +4,13 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <span>
 #include <string_view>
 #include <utility>
 
 #include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
 #include "glm/trigonometric.hpp"
 
 #include "exception.hpp"
@@ -45,16 +47,18 @@ namespace cse::help::collision
     return static_cast<std::int32_t>(std::clamp(value, minimum, maximum));
   }
 
-  std::size_t cell(const std::int32_t z, const std::int32_t x, const std::int32_t y, const int bit)
+  std::size_t cell(const std::int32_t z, const std::int32_t x, const std::int32_t y, const std::uint32_t group)
   {
     auto seed{static_cast<std::size_t>(static_cast<std::uint32_t>(x))};
     const auto mix{[&seed](std::size_t value) { seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6u) + (seed >> 2u); }};
     mix(static_cast<std::size_t>(static_cast<std::uint32_t>(y)));
     mix(static_cast<std::size_t>(static_cast<std::uint32_t>(z)));
-    mix(static_cast<std::size_t>(static_cast<std::uint32_t>(bit)));
+    mix(static_cast<std::size_t>(group));
     return seed;
   }
 
+  std::size_t area::hash::operator()(const area &key) const { return cell(key.z, key.x, key.y, key.group); }
+
   bool overlaps(const rectangle &first, const rectangle &second)
   {
     return first.left < second.right && first.right > second.left && first.bottom < second.top &&
@@ -75,13 +79,46 @@ namespace cse::help::collision
     return animation.frames[frame].hitboxes;
   }
 
+  std::span<const cse::hitbox> world(const cse::object *object, cache &target)
+  {
+    const auto &texture{object->active.texture};
+    const auto &translation{object->active.translation.value};
+    const auto rotation{object->active.rotation.value};
+    const auto &scale{object->active.scale.value};
+    if (target.revision != 0 && target.translation == translation && target.rotation == rotation &&
+        target.scale == scale && target.flip.horizontal == texture.flip.horizontal &&
+        target.flip.vertical == texture.flip.vertical && target.animation == texture.source.animation &&
+        target.frame == texture.playback.frame && target.width == texture.source.image.frame_width &&
+        target.height == texture.source.image.frame_height)
+      return target.boxes;
+
+    target.translation = translation;
+    target.rotation = rotation;
+    target.scale = scale;
+    target.flip = texture.flip;
+    target.animation = texture.source.animation;
+    target.frame = texture.playback.frame;
+    target.width = texture.source.image.frame_width;
+    target.height = texture.source.image.frame_height;
+    target.revision = ++revisions;
+    target.boxes.clear();
+    for (const auto &source : hitboxes(object))
+      target.boxes.push_back(bounds(object, source, translation, rotation, scale));
+    return target.boxes;
+  }
+
   cse::hitbox bounds(const cse::object *object, const cse::hitbox &source)
+  {
+    return bounds(object, source, object->active.translation.value, object->active.rotation.value,
+                  object->active.scale.value);
+  }
+
+  cse::hitbox bounds(const cse::object *object, const cse::hitbox &source, const glm::dvec3 &translation,
+                     const double rotation, const glm::dvec2 &scale)
   {
     auto width{static_cast<double>(object->active.texture.source.image.frame_width)};
     auto height{static_cast<double>(object->active.texture.source.image.frame_height)};
-    auto translation{object->active.translation.value};
-    auto rotation{static_cast<int>(std::floor(object->active.rotation.value + 0.5))};
-    auto scale{object->active.scale.value};
+    const auto turns{static_cast<int>(std::floor(rotation + 0.5))};
     auto flip{object->active.texture.flip};
     const auto &frames{object->active.texture.source.animation.frames};
     glm::dvec2 pivot{(width - 1.0) / 2.0, (height - 1.0) / 2.0};
@@ -108,7 +145,7 @@ namespace cse::help::collision
       local_top = -local_bottom;
       local_bottom = temporary;
     }
-    const int steps{((rotation % 4) + 4) % 4};
+    const int steps{((turns % 4) + 4) % 4};
     const auto local{transform::turn({local_left, local_top, local_right, local_bottom}, steps)};
 
     glm::dvec2 actual_scale{std::floor(scale.x + 0.5), std::floor(scale.y + 0.5)};
@@ -122,6 +159,62 @@ namespace cse::help::collision
             std::floor(pixel.y + (local.bottom * actual_scale.y) + 0.5)};
   }
 
+  std::optional<double> sweep(const cse::hitbox &own_start, const cse::hitbox &own_end,
+                              const cse::hitbox &their_start, const cse::hitbox &their_end)
+  {
+    double enter{0.0};
+    double exit{1.0};
+    const auto clip{[&](const double start, const double end)
+                    {
+                      if (start > 0.0 && end > 0.0) return;
+                      if (start <= 0.0 && end <= 0.0)
+                      {
+                        exit = -1.0;
+                        return;
+                      }
+                      const auto time{start / (start - end)};
+                      if (start <= 0.0)
+                        enter = std::max(enter, time);
+                      else
+                        exit = std::min(exit, time);
+                    }};
+    clip(their_start.right - own_start.left, their_end.right - own_end.left);
+    clip(own_start.right - their_start.left, own_end.right - their_end.left);
+    clip(their_start.top - own_start.bottom, their_end.top - own_end.bottom);
+    clip(own_start.top - their_start.bottom, own_end.top - their_end.bottom);
+    if (enter >= exit) return std::nullopt;
+    return enter;
+  }
+
+  cse::hitbox blend(const cse::hitbox &start, const cse::hitbox &end, const double time)
+  {
+    return {end.name, start.left + ((end.left - start.left) * time), start.top + ((end.top - start.top) * time),
+            start.right + ((end.right - start.right) * time), start.bottom + ((end.bottom - start.bottom) * time)};
+  }
+
+  std::optional<double> pierce(const glm::dvec2 &start, const glm::dvec2 &delta, const cse::hitbox &box)
+  {
+    double enter{0.0};
+    double exit{1.0};
+    const auto clip{[&](const double origin, const double direction, const double low, const double high)
+                    {
+                      if (direction == 0.0)
+                      {
+                        if (origin < low || origin > high) exit = -1.0;
+                        return;
+                      }
+                      auto near{(low - origin) / direction};
+                      auto far{(high - origin) / direction};
+                      if (near > far) std::swap(near, far);
+                      enter = std::max(enter, near);
+                      exit = std::min(exit, far);
+                    }};
+    clip(start.x, delta.x, box.left, box.right);
+    clip(start.y, delta.y, box.bottom, box.top);
+    if (enter > exit) return std::nullopt;
+    return enter;
+  }
+
   contact describe(const name self_name, cse::object *target, const cse::hitbox &own, const cse::hitbox &theirs)
   {
     const glm::dvec2 overlap{std::min(own.right, theirs.right) - std::max(own.left, theirs.left),
@@ -168,7 +261,8 @@ namespace cse::help::collision
             .axis = source.axis,
             .overlap = source.overlap,
             .normal = -source.normal,
-            .penetration = -source.penetration};
+            .penetration = -source.penetration,
+            .impact = source.impact};
   }
 
   cse::hitbox hit(const cse::interface *interface, const glm::dvec2 &point)
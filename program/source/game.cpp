@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -26,7 +27,6 @@
 #include "glm/common.hpp"
 #include "glm/ext/matrix_clip_space.hpp"
 #include "glm/ext/matrix_double4x4.hpp"
-#include "glm/ext/matrix_float4x4.hpp"
 #include "glm/ext/matrix_transform.hpp"
 #include "glm/ext/vector_double2.hpp"
 #include "glm/ext/vector_double3.hpp"
@@ -41,6 +41,7 @@
 #include "container.hpp"
 #include "core.hpp"
 #include "exception.hpp"
+#include "histogram.hpp"
 #include "interface.hpp"
 #include "light.hpp"
 #include "locale.hpp"
@@ -50,20 +51,41 @@
 #include "name.hpp"
 #include "numeric.hpp"
 #include "object.hpp"
+#include "radix.hpp"
 #include "resource.hpp"
 #include "shader.hpp"
 #include "system.hpp"
 #include "temporal.hpp"
+#include "trace.hpp"
 #include "transform.hpp"
 #include "window.hpp"
+#include "worker.hpp"
+
+namespace
+{
+  std::uint8_t unorm8(const double value)
+  { return static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0, 1.0) * 255.0)); }
+
+  std::uint16_t unorm16(const double value)
+  { return static_cast<std::uint16_t>(std::lround(std::clamp(value, 0.0, 1.0) * 65535.0)); }
+
+  std::uint32_t pack(const int steps, const bool lit, const bool shadowed, const double transparency,
+                     const float occluder)
+  {
+    const auto index{occluder < 0.0f ? 0u : static_cast<std::uint32_t>(occluder) + 1u};
+    return (static_cast<std::uint32_t>(steps) & 0x3u) | (lit ? 0x4u : 0u) | (shadowed ? 0x8u : 0u) |
+           (static_cast<std::uint32_t>(unorm8(transparency)) << 4) | (std::min(index, 0xFFFFFu) << 12);
+  }
+}
 
 namespace cse::help::game
 {
   active::active(const double tick_, const double frame_, const game::aspect &aspect_,
                  const temporal<glm::dvec3> &clear_, const game::memory::initial &memory_, const std::string &language_,
-                 const temporal<double> &master_, const temporal<double> &sound_, const temporal<double> &music_)
+                 const temporal<double> &master_, const temporal<double> &sound_, const temporal<double> &music_,
+                 const bool pace_, const game::headless &headless_)
     : tick(tick_), frame(frame_), aspect(aspect_), clear(clear_), memory({{}, memory_.vram}, {{}, memory_.ram}),
-      language(language_), master(master_), sound(sound_), music(music_) {};
+      language(language_), master(master_), sound(sound_), music(music_), pace(pace_), headless(headless_) {};
 
   void active::prepare()
   {
@@ -80,9 +102,14 @@ namespace cse::help::game
                                     (meta.organization + "-" + meta.application + "-" + meta.version).c_str()))
       sdl_log("Could not set app metadata identifier");
 
-    if (!SDL_InitSubSystem(SDL_INIT_VIDEO)) throw sdl_exception("SDL could not be prepared");
     audio_ready = false;
-    if (!SDL_InitSubSystem(SDL_INIT_AUDIO))
+    if (headless.enabled)
+    {
+      if (!SDL_InitSubSystem(SDL_INIT_EVENTS)) throw sdl_exception("SDL could not be prepared");
+    }
+    else if (!SDL_InitSubSystem(SDL_INIT_VIDEO))
+      throw sdl_exception("SDL could not be prepared");
+    else if (!SDL_InitSubSystem(SDL_INIT_AUDIO))
       sdl_log("SDL audio could not be prepared; continuing without sound");
     else if (!MIX_Init())
       sdl_log("SDL_mixer could not be prepared; continuing without sound");
@@ -91,10 +118,12 @@ namespace cse::help::game
 
     help::locale::resolve(language);
     help::collision::verify();
+    worker.start(std::max(1u, std::thread::hardware_concurrency()) - 1);
   }
 
   void active::create()
   {
+    if (headless.enabled) return;
     if (!SDL_GPUSupportsShaderFormats(shader_format, gpu_backend))
       throw sdl_exception("No supported shader formats found for {}", gpu_backend);
     video = SDL_CreateGPUDevice(shader_format, debug, gpu_backend);
@@ -213,6 +242,7 @@ namespace cse::help::game
 
     last.tick = tick;
     last.frame = frame;
+    last.timing = timing;
     last.aspect = aspect;
     last.clear = clear;
     last.memory = memory;
@@ -230,16 +260,7 @@ namespace cse::help::game
     last.mixer = mixer;
     last.phase = phase;
 
-    for (auto &[name, track] : mixer.sounds)
-    {
-      track.speed.instant = false;
-      track.volume.instant = false;
-    }
-    for (auto &[name, track] : mixer.musics)
-    {
-      track.speed.instant = false;
-      track.volume.instant = false;
-    }
+    mixer.settle();
     clear.instant = false;
     master.instant = false;
     sound.instant = false;
@@ -259,6 +280,11 @@ namespace cse::help::game
                               0.0};
       return std::pair<glm::dmat4, glm::dmat4>{projection, glm::translate(glm::dmat4{1.0}, origin)};
     }();
+  }
+
+  void active::upload()
+  {
+    CSE_TRACE_ZONE("game::upload");
     while (actual_vram.current > actual_vram.maximum)
     {
       auto oldest{graphics_cache.texture.end()};
@@ -413,10 +439,13 @@ namespace cse::help::game
     for (const auto &element : interfaces) add(element.get());
 
     for (auto &[key, audio] : audio_cache.tracks) audio.seen = false;
-    for (const auto &audio : channels)
     {
-      reconcile_audio<cse::sound>(audio.previous, audio.active, "sound", true, sound_bus);
-      reconcile_audio<cse::music>(audio.previous, audio.active, "music", false, music_bus);
+      CSE_TRACE_ZONE("game::reconcile_audio");
+      for (const auto &audio : channels)
+      {
+        reconcile_audio<cse::sound>(audio.previous, audio.active, "sound", true, sound_bus);
+        reconcile_audio<cse::music>(audio.previous, audio.active, "music", false, music_bus);
+      }
     }
     for (auto iterator{audio_cache.tracks.begin()}; iterator != audio_cache.tracks.end();)
       if (!iterator->second.seen)
@@ -457,22 +486,25 @@ namespace cse::help::game
     if (soundboard) MIX_DestroyMixer(soundboard);
     soundboard = nullptr;
 
-    SDL_ReleaseGPUTransferBuffer(video, graphics_object.transfer_buffer);
-    SDL_ReleaseGPUBuffer(video, graphics_object.buffer);
-    SDL_ReleaseGPUTransferBuffer(video, graphics_occluder.transfer_buffer);
-    SDL_ReleaseGPUBuffer(video, graphics_occluder.buffer);
-    SDL_ReleaseGPUTexture(video, graphics_occluder.texture);
-    SDL_ReleaseGPUTransferBuffer(video, graphics_light.transfer_buffer);
-    SDL_ReleaseGPUBuffer(video, graphics_light.buffer);
-    for (const auto &[key, texture] : graphics_cache.texture) SDL_ReleaseGPUTexture(video, texture.value);
-    SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.interface);
-    SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.transparent);
-    SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.opaque);
-    SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.depth);
-    SDL_ReleaseGPUSampler(video, graphics_buffer.nearest);
-    SDL_ReleaseGPUBuffer(video, graphics_buffer.index);
-    SDL_ReleaseGPUBuffer(video, graphics_buffer.vertex);
-    SDL_DestroyGPUDevice(video);
+    if (video)
+    {
+      SDL_ReleaseGPUTransferBuffer(video, graphics_object.transfer_buffer);
+      SDL_ReleaseGPUBuffer(video, graphics_object.buffer);
+      SDL_ReleaseGPUTransferBuffer(video, graphics_occluder.transfer_buffer);
+      SDL_ReleaseGPUBuffer(video, graphics_occluder.buffer);
+      SDL_ReleaseGPUTexture(video, graphics_occluder.texture);
+      SDL_ReleaseGPUTransferBuffer(video, graphics_light.transfer_buffer);
+      SDL_ReleaseGPUBuffer(video, graphics_light.buffer);
+      for (const auto &[key, texture] : graphics_cache.texture) SDL_ReleaseGPUTexture(video, texture.value);
+      SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.interface);
+      SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.transparent);
+      SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.opaque);
+      SDL_ReleaseGPUGraphicsPipeline(video, graphics_pipeline.depth);
+      SDL_ReleaseGPUSampler(video, graphics_buffer.nearest);
+      SDL_ReleaseGPUBuffer(video, graphics_buffer.index);
+      SDL_ReleaseGPUBuffer(video, graphics_buffer.vertex);
+      SDL_DestroyGPUDevice(video);
+    }
     graphics_interface.order.clear();
     graphics_text.blocks.clear();
     graphics_text.quads.clear();
@@ -509,9 +541,10 @@ namespace cse::help::game
 
   void active::clean()
   {
+    worker.stop();
     MIX_Quit();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
-    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    SDL_QuitSubSystem(headless.enabled ? SDL_INIT_EVENTS : SDL_INIT_VIDEO);
     SDL_Quit();
   }
 
@@ -609,6 +642,7 @@ namespace cse::help::game
 
   void active::generate_graphics_order()
   {
+    CSE_TRACE_ZONE("game::generate_graphics_order");
     const auto comparator{[](const cse::interface *left, const cse::interface *right)
                           {
                             if (left->active.priority.rendering != right->active.priority.rendering)
@@ -660,8 +694,9 @@ namespace cse::help::game
     }
   }
 
-  void active::generate_text(const std::vector<cse::object *> &object_order)
+  void active::generate_text(const std::vector<cse::object *> &object_order, const help::transform::store &transforms)
   {
+    CSE_TRACE_ZONE("game::generate_text");
     static constexpr double cull_margin{2.0};
     graphics_text.quads.clear();
     graphics_text.blocks.assign(object_order.size(), {});
@@ -714,8 +749,9 @@ namespace cse::help::game
         std::max(0.0, illumination.penetration.interpolated(element->previous.text.illumination.penetration, alpha));
       block.darkness = std::max(0.0, shadow.darkness.interpolated(element->previous.text.shadow.darkness, alpha));
       block.softness = std::max(0.0, shadow.softness.interpolated(element->previous.text.shadow.softness, alpha));
-      block.steps =
-        static_cast<int>(std::floor(element->active.rotation.interpolated(element->previous.rotation, alpha) + 0.5));
+      const auto translation{transforms.translation.at(element->slot)};
+      const auto rotation{transforms.rotation.at(element->slot)};
+      block.steps = static_cast<int>(std::floor(rotation + 0.5));
       const bool rotated{(((block.steps % 4) + 4) % 4) % 2 == 1};
 
       double minimum_x{}, minimum_y{}, maximum_x{}, maximum_y{};
@@ -723,23 +759,22 @@ namespace cse::help::game
       {
         const auto quad_width{entry.right - entry.left};
         const auto quad_height{entry.top - entry.bottom};
-        const glm::dmat4 matrix{element->active.calculate_text_matrix(
-          element->previous, quad_width, quad_height,
-          {(entry.left + entry.right) / 2.0, (entry.top + entry.bottom) / 2.0}, alpha)};
-        const glm::mat4 model{matrix};
         graphics_text::quad quad{};
-        SDL_memcpy(quad.model.data(), &model, sizeof(model));
+        quad.placement = element->active.calculate_text_placement(
+          translation, rotation, quad_width, quad_height,
+          {(entry.left + entry.right) / 2.0, (entry.top + entry.bottom) / 2.0});
+        const auto &origin{quad.placement.center};
         quad.left = static_cast<float>(entry.uv_left);
         quad.bottom = static_cast<float>(entry.uv_bottom);
         quad.right = static_cast<float>(entry.uv_right);
         quad.top = static_cast<float>(entry.uv_top);
         const auto half_width{std::floor(quad_width + 0.5) / 2.0};
         const auto half_height{std::floor(quad_height + 0.5) / 2.0};
-        quad.minimum_x = matrix[3].x - (rotated ? half_height : half_width);
-        quad.maximum_x = matrix[3].x + (rotated ? half_height : half_width);
-        quad.minimum_y = matrix[3].y - (rotated ? half_width : half_height);
-        quad.maximum_y = matrix[3].y + (rotated ? half_width : half_height);
-        block.plane = matrix[3].z;
+        quad.minimum_x = origin.x - (rotated ? half_height : half_width);
+        quad.maximum_x = origin.x + (rotated ? half_height : half_width);
+        quad.minimum_y = origin.y - (rotated ? half_width : half_height);
+        quad.maximum_y = origin.y + (rotated ? half_width : half_height);
+        block.plane = origin.z;
         if (graphics_text.quads.size() == block.first)
         {
           minimum_x = quad.minimum_x;
@@ -768,6 +803,7 @@ namespace cse::help::game
 
   void active::generate_lights(const std::vector<cse::light *> &light_order)
   {
+    CSE_TRACE_ZONE("game::generate_lights");
     graphics_light.data.meta.at(0) = static_cast<float>(light_order.size());
     graphics_light.samples.clear();
     graphics_light.samples.reserve(light_order.size());
@@ -811,8 +847,10 @@ namespace cse::help::game
     }
   }
 
-  void active::generate_occluders(const std::vector<cse::object *> &object_order)
+  void active::generate_occluders(const std::vector<cse::object *> &object_order,
+                                  const help::transform::store &transforms)
   {
+    CSE_TRACE_ZONE("game::generate_occluders");
     graphics_occluder.samples.clear();
 
     bool additions{false};
@@ -854,9 +892,9 @@ namespace cse::help::game
       if (frame_index >= frame_count) frame_index = frame_count - 1;
       const auto &coordinates{element->active.texture.source.animation.frames[frame_index].coordinates};
       const auto &flip{element->active.texture.flip};
-      const auto translation{element->active.translation.interpolated(element->previous.translation, alpha)};
-      const auto rotation{element->active.rotation.interpolated(element->previous.rotation, alpha)};
-      const auto scale{element->active.scale.interpolated(element->previous.scale, alpha)};
+      const auto translation{transforms.translation.at(element->slot)};
+      const auto rotation{transforms.rotation.at(element->slot)};
+      const auto scale{transforms.scale.at(element->slot)};
       const auto transparency{std::clamp(
         element->active.texture.color.alpha.interpolated(element->previous.texture.color.alpha, alpha), 0.0, 1.0)};
       const int steps{((static_cast<int>(std::floor(rotation + 0.5)) % 4) + 4) % 4};
@@ -973,7 +1011,7 @@ namespace cse::help::game
       for (auto &entry : graphics_occluder.samples)
         entry.surface.at(1) = remap.at(static_cast<std::size_t>(entry.surface.at(1)));
     }
-    if ((additions || pruned) && !graphics_occluder.layers.empty())
+    if ((additions || pruned) && !graphics_occluder.layers.empty() && video)
     {
       unsigned int max_width{1};
       unsigned int max_height{1};
@@ -1156,11 +1194,12 @@ namespace cse::help::game
     }
   }
 
-  void active::generate_objects(const std::vector<cse::object *> &object_order)
+  void active::generate_objects(const std::vector<cse::object *> &object_order,
+                                const help::transform::store &transforms)
   {
+    CSE_TRACE_ZONE("game::generate_objects");
     graphics_object.samples.clear();
     graphics_object.batches.clear();
-    graphics_object.samples.reserve(object_order.size() + graphics_text.quads.size());
     static constexpr double depth_bias_span{0.001};
     static constexpr double cull_margin{2.0};
     const auto object_total{object_order.size()};
@@ -1188,9 +1227,9 @@ namespace cse::help::game
       if (current >= size) current = size - 1;
       transparencies.push_back(
         element->active.texture.color.alpha.interpolated(element->previous.texture.color.alpha, alpha));
-      const auto translation{element->active.translation.interpolated(element->previous.translation, alpha)};
-      const auto rotation{element->active.rotation.interpolated(element->previous.rotation, alpha)};
-      const auto scale{element->active.scale.interpolated(element->previous.scale, alpha)};
+      const auto translation{transforms.translation.at(element->slot)};
+      const auto rotation{transforms.rotation.at(element->slot)};
+      const auto scale{transforms.scale.at(element->slot)};
       const auto scale_x{std::floor(scale.x + 0.5)};
       const auto scale_y{std::floor(scale.y + 0.5)};
       const auto width{scale_x * static_cast<double>(element->active.texture.source.image.frame_width)};
@@ -1233,86 +1272,133 @@ namespace cse::help::game
       if (drawn_slot(slot) && opaque_slot(slot)) emission_order.push_back(slot);
     for (std::size_t slot{}; slot < slot_total; ++slot)
       if (drawn_slot(slot) && !opaque_slot(slot)) emission_order.push_back(slot);
-    for (const auto slot : emission_order)
+
+    static constexpr std::uint64_t transparent_key{std::uint64_t{1} << 63};
+    static constexpr std::uint64_t field_mask{0xFFFF};
+    static constexpr std::uint64_t index_mask{0xFFFFFF};
+    auto &keys{graphics_object.keys};
+    auto &targets{graphics_object.targets};
+    auto &textures{graphics_object.textures};
+    keys.clear();
+    targets.clear();
+    textures.clear();
+    keys.reserve(emission_order.size());
+    targets.reserve(emission_order.size());
+    const auto packed{emission_order.size() <= index_mask};
+    auto &available{require_pipelines()};
+    std::uint64_t layer{};
+    double last_z{};
+    for (std::size_t index{}; index < emission_order.size(); ++index)
     {
+      const auto slot{emission_order.at(index)};
       const auto position{slot / 2};
       auto *element{object_order.at(position)};
-      const auto depth{static_cast<float>(static_cast<double>(slot) * depth_bias_step)};
-      if (slot % 2 == 1)
+      const auto &block{graphics_text.blocks.at(position)};
+      const auto opaque{opaque_slot(slot)};
+      auto *texture{require_texture(slot % 2 == 1 ? block.image : element->active.texture.source.image)};
+      targets.push_back({opaque ? available.opaque : available.transparent, texture});
+      if (!packed || !opaque)
       {
-        const auto &block{graphics_text.blocks.at(position)};
-        auto &available{require_pipelines()};
-        auto *pipe{block.transparency < 1.0 ? available.transparent : available.opaque};
-        auto *atlas{require_texture(block.image)};
-        for (std::size_t index{block.first}; index < block.first + block.count; ++index)
-        {
-          const auto &quad{graphics_text.quads.at(index)};
-          graphics_object::sample data{};
-          data.model = quad.model;
-          data.red = block.red;
-          data.green = block.green;
-          data.blue = block.blue;
-          data.alpha = block.alpha;
-          data.left = quad.left;
-          data.bottom = quad.bottom;
-          data.right = quad.right;
-          data.top = quad.top;
-          data.lit = block.lit ? 1.0f : 0.0f;
-          data.shadowed = block.shadowed ? 1.0f : 0.0f;
-          data.brightness = static_cast<float>(block.brightness);
-          data.transparency = static_cast<float>(block.transparency);
-          data.depth = depth;
-          data.occluder = quad.occluder;
-          if (!graphics_object.batches.empty() && graphics_object.batches.back().pipeline == pipe &&
-              graphics_object.batches.back().texture == atlas)
-            graphics_object.batches.back().count++;
-          else
-            graphics_object.batches.push_back({graphics_object.samples.size(), 1, pipe, atlas});
-          graphics_object.samples.push_back(data);
-        }
+        keys.push_back((opaque ? 0 : transparent_key) | index);
         continue;
       }
-      const auto &coordinates{
-        element->active.texture.source.animation.frames[element->active.texture.playback.frame].coordinates};
-      const auto &flip{element->active.texture.flip};
-      const auto color{
-        glm::vec4{element->active.texture.color.tint.interpolated(element->previous.texture.color.tint, alpha)}};
-      const auto transparency{transparencies.at(position)};
-      const glm::mat4 model{element->active.calculate_model_matrix(
-        element->previous, element->active.texture.source.image.frame_width,
-        element->active.texture.source.image.frame_height,
-        element->active.texture.source.animation.frames[element->active.texture.playback.frame].pivot, alpha)};
-      graphics_object::sample data{};
-      SDL_memcpy(data.model.data(), &model, sizeof(model));
-      data.red = color.r;
-      data.green = color.g;
-      data.blue = color.b;
-      data.alpha = color.a;
-      data.left = static_cast<float>(flip.horizontal ? coordinates.right : coordinates.left);
-      data.bottom = static_cast<float>(flip.vertical ? coordinates.top : coordinates.bottom);
-      data.right = static_cast<float>(flip.horizontal ? coordinates.left : coordinates.right);
-      data.top = static_cast<float>(flip.vertical ? coordinates.bottom : coordinates.top);
-      data.lit = element->active.texture.illumination.show ? 1.0f : 0.0f;
-      data.shadowed = element->active.texture.shadow.show ? 1.0f : 0.0f;
-      data.brightness = static_cast<float>(element->active.texture.illumination.brightness.interpolated(
-        element->previous.texture.illumination.brightness, alpha));
-      data.transparency = static_cast<float>(transparency);
-      data.depth = depth;
-      data.occluder = position < graphics_occluder.indices.size() ? graphics_occluder.indices.at(position) : -1.0f;
-      auto &available{require_pipelines()};
-      auto *pipe{transparency < 1.0 ? available.transparent : available.opaque};
-      auto *texture{require_texture(element->active.texture.source.image)};
+      const auto z{std::floor(transforms.translation.at(element->slot).z + 0.5)};
+      if (index > 0 && z != last_z) ++layer;
+      last_z = z;
+      const auto identifier{textures.try_emplace(texture, static_cast<std::uint32_t>(textures.size())).first->second};
+      keys.push_back((std::min(layer, field_mask) << 40) | (std::min<std::uint64_t>(identifier, field_mask) << 24) |
+                     index);
+    }
+    help::radix_sort(keys, graphics_object.scratch);
+
+    const auto locate{[&](const std::uint64_t key)
+                      { return static_cast<std::size_t>(packed ? key & index_mask : key & ~transparent_key); }};
+    auto &offsets{graphics_object.offsets};
+    offsets.clear();
+    offsets.reserve(keys.size() + 1);
+    offsets.push_back(0);
+    for (const auto key : keys)
+    {
+      const auto slot{emission_order.at(locate(key))};
+      offsets.push_back(offsets.back() + (slot % 2 == 1 ? graphics_text.blocks.at(slot / 2).count : 1));
+    }
+    graphics_object.samples.resize(offsets.back());
+
+    const auto fill{[&](const std::size_t sorted)
+                    {
+                      const auto slot{emission_order.at(locate(keys.at(sorted)))};
+                      const auto position{slot / 2};
+                      auto *element{object_order.at(position)};
+                      const auto depth{static_cast<float>(static_cast<double>(slot) * depth_bias_step)};
+                      auto *output{graphics_object.samples.data() + offsets.at(sorted)};
+                      if (slot % 2 == 1)
+                      {
+                        const auto &block{graphics_text.blocks.at(position)};
+                        for (std::size_t index{block.first}; index < block.first + block.count; ++index)
+                        {
+                          const auto &quad{graphics_text.quads.at(index)};
+                          auto &data{*output++};
+                          place(data, quad.placement);
+                          data.color = {unorm8(block.red), unorm8(block.green), unorm8(block.blue),
+                                        unorm8(block.alpha)};
+                          data.frame = {unorm16(quad.left), unorm16(quad.bottom), unorm16(quad.right),
+                                        unorm16(quad.top)};
+                          data.depth = depth;
+                          data.brightness = static_cast<float>(block.brightness);
+                          data.flags = pack(quad.placement.steps, block.lit, block.shadowed, block.transparency,
+                                            quad.occluder);
+                        }
+                        return;
+                      }
+                      const auto &frame{
+                        element->active.texture.source.animation.frames[element->active.texture.playback.frame]};
+                      const auto &coordinates{frame.coordinates};
+                      const auto &flip{element->active.texture.flip};
+                      const auto color{glm::vec4{
+                        element->active.texture.color.tint.interpolated(element->previous.texture.color.tint, alpha)}};
+                      const auto placement{element->active.calculate_model_placement(
+                        transforms.translation.at(element->slot), transforms.rotation.at(element->slot),
+                        transforms.scale.at(element->slot), element->active.texture.source.image.frame_width,
+                        element->active.texture.source.image.frame_height, frame.pivot)};
+                      auto &data{*output};
+                      place(data, placement);
+                      data.color = {unorm8(color.r), unorm8(color.g), unorm8(color.b), unorm8(color.a)};
+                      data.frame = {unorm16(flip.horizontal ? coordinates.right : coordinates.left),
+                                    unorm16(flip.vertical ? coordinates.top : coordinates.bottom),
+                                    unorm16(flip.horizontal ? coordinates.left : coordinates.right),
+                                    unorm16(flip.vertical ? coordinates.bottom : coordinates.top)};
+                      data.depth = depth;
+                      data.brightness = static_cast<float>(element->active.texture.illumination.brightness.interpolated(
+                        element->previous.texture.illumination.brightness, alpha));
+                      data.flags = pack(
+                        placement.steps, element->active.texture.illumination.show,
+                        element->active.texture.shadow.show, transparencies.at(position),
+                        position < graphics_occluder.indices.size() ? graphics_occluder.indices.at(position) : -1.0f);
+                    }};
+    worker.run((keys.size() + sample_grain - 1) / sample_grain,
+               [&](const std::size_t chunk)
+               {
+                 const auto first{chunk * sample_grain};
+                 const auto last{std::min(keys.size(), first + sample_grain)};
+                 for (auto sorted{first}; sorted < last; ++sorted) fill(sorted);
+               });
+
+    for (std::size_t sorted{}; sorted < keys.size(); ++sorted)
+    {
+      const auto count{offsets.at(sorted + 1) - offsets.at(sorted)};
+      if (count == 0) continue;
+      const auto [pipe, texture]{targets.at(locate(keys.at(sorted)))};
       if (!graphics_object.batches.empty() && graphics_object.batches.back().pipeline == pipe &&
           graphics_object.batches.back().texture == texture)
-        graphics_object.batches.back().count++;
+        graphics_object.batches.back().count += count;
       else
-        graphics_object.batches.push_back({graphics_object.samples.size(), 1, pipe, texture});
-      graphics_object.samples.push_back(data);
+        graphics_object.batches.push_back({offsets.at(sorted), count, pipe, texture});
     }
   }
 
   void active::generate_interfaces()
   {
+    CSE_TRACE_ZONE("game::generate_interfaces");
     graphics_object.split = graphics_object.batches.size();
     graphics_object.samples.reserve(graphics_object.samples.size() + graphics_interface.order.size());
     for (auto *element : graphics_interface.order)
@@ -1329,21 +1415,19 @@ namespace cse::help::game
         glm::vec4{element->active.texture.color.tint.interpolated(element->previous.texture.color.tint, alpha)}};
       const auto transparency{
         element->active.texture.color.alpha.interpolated(element->previous.texture.color.alpha, alpha)};
-      const glm::mat4 model{
-        element->active.calculate_model_matrix(element->previous, element->active.texture.source.image.frame_width,
-                                               element->active.texture.source.image.frame_height,
-                                               element->active.texture.source.animation.frames[current].pivot, alpha)};
+      const auto placement{
+        element->active.calculate_model_placement(element->previous, element->active.texture.source.image.frame_width,
+                                                  element->active.texture.source.image.frame_height,
+                                                  element->active.texture.source.animation.frames[current].pivot,
+                                                  alpha)};
       graphics_object::sample data{};
-      SDL_memcpy(data.model.data(), &model, sizeof(model));
-      data.red = color.r;
-      data.green = color.g;
-      data.blue = color.b;
-      data.alpha = color.a;
-      data.left = static_cast<float>(flip.horizontal ? coordinates.right : coordinates.left);
-      data.right = static_cast<float>(flip.horizontal ? coordinates.left : coordinates.right);
-      data.top = static_cast<float>(flip.vertical ? coordinates.bottom : coordinates.top);
-      data.bottom = static_cast<float>(flip.vertical ? coordinates.top : coordinates.bottom);
-      data.transparency = static_cast<float>(transparency);
+      place(data, placement);
+      data.color = {unorm8(color.r), unorm8(color.g), unorm8(color.b), unorm8(color.a)};
+      data.frame = {unorm16(flip.horizontal ? coordinates.right : coordinates.left),
+                    unorm16(flip.vertical ? coordinates.top : coordinates.bottom),
+                    unorm16(flip.horizontal ? coordinates.left : coordinates.right),
+                    unorm16(flip.vertical ? coordinates.bottom : coordinates.top)};
+      data.flags = pack(placement.steps, false, false, transparency, -1.0f);
       auto &available{require_pipelines()};
       auto *pipe{available.interface};
       auto *texture{require_texture(element->active.texture.source.image)};
@@ -1377,20 +1461,15 @@ namespace cse::help::game
       auto *atlas{require_texture(text.source.font.image)};
       for (const auto &entry : graphics_text.scratch)
       {
-        const glm::mat4 text_model{element->active.calculate_text_matrix(
+        const auto text_placement{element->active.calculate_text_placement(
           element->previous, entry.right - entry.left, entry.top - entry.bottom,
           {(entry.left + entry.right) / 2.0, (entry.top + entry.bottom) / 2.0}, alpha)};
         graphics_object::sample text_data{};
-        SDL_memcpy(text_data.model.data(), &text_model, sizeof(text_model));
-        text_data.red = text_color.r;
-        text_data.green = text_color.g;
-        text_data.blue = text_color.b;
-        text_data.alpha = text_color.a;
-        text_data.left = static_cast<float>(entry.uv_left);
-        text_data.bottom = static_cast<float>(entry.uv_bottom);
-        text_data.right = static_cast<float>(entry.uv_right);
-        text_data.top = static_cast<float>(entry.uv_top);
-        text_data.transparency = static_cast<float>(text_alpha);
+        place(text_data, text_placement);
+        text_data.color = {unorm8(text_color.r), unorm8(text_color.g), unorm8(text_color.b), unorm8(text_color.a)};
+        text_data.frame = {unorm16(entry.uv_left), unorm16(entry.uv_bottom), unorm16(entry.uv_right),
+                           unorm16(entry.uv_top)};
+        text_data.flags = pack(text_placement.steps, false, false, text_alpha, -1.0f);
         if (!graphics_object.batches.empty() && graphics_object.batches.back().pipeline == pipe &&
             graphics_object.batches.back().texture == atlas)
           graphics_object.batches.back().count++;
@@ -1413,6 +1492,16 @@ namespace cse::help::game
            image.frame_height > 0 && image.channels > 0;
   }
 
+  void active::place(graphics_object::sample &data, const help::transform::placement &placement)
+  {
+    static constexpr double extent{32767.0};
+    data.x = static_cast<float>(placement.center.x);
+    data.y = static_cast<float>(placement.center.y);
+    data.z = static_cast<float>(placement.center.z);
+    data.width = static_cast<std::int16_t>(std::lround(std::clamp(placement.size.x, -extent, extent)));
+    data.height = static_cast<std::int16_t>(std::lround(std::clamp(placement.size.y, -extent, extent)));
+  }
+
   struct active::graphics_pipeline &active::require_pipelines()
   {
     if (graphics_pipeline.opaque) return graphics_pipeline;
@@ -1446,20 +1535,18 @@ namespace cse::help::game
         .pitch = sizeof(graphics_object::sample),
         .input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE,
         .instance_step_rate = 0}}};
-    const std::array<SDL_GPUVertexAttribute, 9> vertex_attributes{
+    const std::array<SDL_GPUVertexAttribute, 7> vertex_attributes{
       {{0, 0, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(corner, x)},
-       {1, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, model)},
-       {2, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, model) + (sizeof(float) * 4)},
-       {3, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, model) + (sizeof(float) * 8)},
-       {4, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, model) + (sizeof(float) * 12)},
-       {5, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, red)},
-       {6, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, left)},
-       {7, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(graphics_object::sample, lit)},
-       {8, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2, offsetof(graphics_object::sample, depth)}}};
+       {1, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, offsetof(graphics_object::sample, x)},
+       {2, 1, SDL_GPU_VERTEXELEMENTFORMAT_SHORT2, offsetof(graphics_object::sample, width)},
+       {3, 1, SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM, offsetof(graphics_object::sample, color)},
+       {4, 1, SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM, offsetof(graphics_object::sample, frame)},
+       {5, 1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2, offsetof(graphics_object::sample, depth)},
+       {6, 1, SDL_GPU_VERTEXELEMENTFORMAT_UINT, offsetof(graphics_object::sample, flags)}}};
     const SDL_GPUVertexInputState vertex_input_state{.vertex_buffer_descriptions = vertex_buffer_descriptions.data(),
                                                      .num_vertex_buffers = 2,
                                                      .vertex_attributes = vertex_attributes.data(),
-                                                     .num_vertex_attributes = 9};
+                                                     .num_vertex_attributes = 7};
     SDL_GPURasterizerState rasterizer_state{};
     rasterizer_state.fill_mode = SDL_GPU_FILLMODE_FILL;
     rasterizer_state.cull_mode = SDL_GPU_CULLMODE_NONE;
@@ -1574,6 +1661,7 @@ namespace cse::help::game
   SDL_GPUTexture *active::require_texture(const cse::image &image)
   {
     if (!usable(image)) throw exception("Could not create texture for game from an empty image");
+    if (!video) return nullptr;
     const graphics_cache::texture_key key{image.data.data(), image.data.size()};
     if (const auto iterator{graphics_cache.texture.find(key)}; iterator != graphics_cache.texture.end())
     {
@@ -1665,7 +1753,8 @@ namespace cse
 {
   game::game(const initial &initial_)
     : active{initial_.tick,     initial_.frame,  initial_.aspect, initial_.clear, initial_.memory,
-             initial_.language, initial_.master, initial_.sound,  initial_.music}
+             initial_.language, initial_.master, initial_.sound,  initial_.music, initial_.pace,
+             initial_.headless}
   {
   }
 
@@ -1717,6 +1806,7 @@ namespace cse
       mix();
       fps();
     }
+    pace();
     return running() ? SDL_APP_CONTINUE : SDL_APP_SUCCESS;
   }
 
@@ -1724,6 +1814,7 @@ namespace cse
   {
     if (active.phase == help::phase::CREATED) destroy();
     if (active.phase == help::phase::PREPARED) clean();
+    help::trace::flush();
     instance.reset();
   }
 
@@ -1763,6 +1854,8 @@ namespace cse
   void game::synchronize()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before synchronization");
+    CSE_TRACE_ZONE("game::synchronize");
+    const auto start{clock()};
     pre_synchronize();
     active.synchronize(previous);
     if (next.window.has_value())
@@ -1835,6 +1928,7 @@ namespace cse
     active.generate_simulation_order();
     active.generate_pool();
     post_synchronize();
+    active.profile.synchronize.record(clock() - start);
   }
 
   void game::pre_event(const SDL_Event &) {}
@@ -1842,7 +1936,9 @@ namespace cse
   void game::event()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before processing events");
-    active.window->active.poll(active.aspect);
+    CSE_TRACE_ZONE("game::event");
+    const auto start{clock()};
+    if (!active.headless.enabled) active.window->active.poll(active.aspect);
     for (const auto &item : queue)
     {
       pre_event(item);
@@ -1854,6 +1950,7 @@ namespace cse
     }
     queue.clear();
     active.hover();
+    active.profile.event.record(clock() - start);
   }
 
   void game::pre_simulate(const double) {}
@@ -1861,6 +1958,8 @@ namespace cse
   void game::simulate()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before simulation");
+    CSE_TRACE_ZONE("game::simulate");
+    const auto start{clock()};
     pre_simulate(active.actual_tick);
     active.timer.simulate(active.actual_tick);
     active.mixer.simulate(active.actual_tick);
@@ -1868,6 +1967,7 @@ namespace cse
     active.scene->simulate(active.actual_tick);
     for (const auto &interface : active.interface_order) interface->simulate(active.actual_tick);
     post_simulate(active.actual_tick);
+    active.profile.simulate.record(clock() - start);
   }
 
   void game::pre_collide(const double) {}
@@ -1875,9 +1975,12 @@ namespace cse
   void game::collide()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before collision");
+    CSE_TRACE_ZONE("game::collide");
+    const auto start{clock()};
     pre_collide(active.actual_tick);
     active.scene->collide(active.actual_tick);
     post_collide(active.actual_tick);
+    active.profile.collide.record(clock() - start);
   }
 
   void game::pre_render(const double) {}
@@ -1885,12 +1988,30 @@ namespace cse
   void game::render()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before rendering");
+    CSE_TRACE_ZONE("game::render");
     pre_render(active.alpha);
     const auto clear{active.clear.interpolated(previous.clear, active.alpha)};
+    const auto generate{[this]()
+                        {
+                          const auto start{clock()};
+                          active.scene->render(active.aspect.ratio, active.alpha);
+                          active.render();
+                          active.profile.prepare.record(clock() - start);
+                        }};
+    if (active.headless.enabled)
+    {
+      if (active.headless.render) generate();
+      post_render(active.alpha);
+      return;
+    }
     if (!active.window->available(active.video)) return;
-    active.scene->render(active.aspect.ratio, active.alpha);
-    active.render();
+    generate();
+    const auto upload{clock()};
+    active.upload();
+    const auto submit{clock()};
+    active.profile.upload.record(submit - upload);
     active.window->render(clear, active.alpha);
+    active.profile.submit.record(clock() - submit);
     post_render(active.alpha);
   }
 
@@ -1899,9 +2020,12 @@ namespace cse
   void game::mix()
   {
     if (active.phase != help::phase::CREATED) throw exception("Game must be created before mixing");
+    CSE_TRACE_ZONE("game::mix");
+    const auto start{clock()};
     pre_mix(active.alpha);
     active.mix(previous.mixer, previous.master, previous.sound, previous.music);
     post_mix(active.alpha);
+    active.profile.mix.record(clock() - start);
   }
 
   void game::pre_destroy() {}
@@ -1932,7 +2056,13 @@ namespace cse
     post_clean();
   }
 
-  void game::time() { active.time = static_cast<double>(SDL_GetTicksNS()) / 1e9; }
+  void game::time()
+  {
+    if (active.headless.enabled && active.headless.unthrottled) return;
+    active.time = clock();
+  }
+
+  double game::clock() { return static_cast<double>(SDL_GetTicksNS()) / 1e9; }
 
   void game::step()
   {
@@ -1953,10 +2083,16 @@ namespace cse
     active.memory.vram.current = active.actual_vram.current / (1024u * 1024u);
     active.memory.ram.current = active.actual_ram.current / (1024u * 1024u);
 
+    if (active.headless.enabled && active.headless.unthrottled)
+    {
+      active.time += active.actual_tick;
+      active.simulation_time = active.time;
+      active.accumulator += active.actual_tick;
+      return;
+    }
     time();
-    static std::optional<double> simulation_time{};
-    const double delta_time{simulation_time ? active.time - simulation_time.value() : 0.0};
-    simulation_time = active.time;
+    const double delta_time{active.simulation_time ? active.time - active.simulation_time.value() : 0.0};
+    active.simulation_time = active.time;
     active.accumulator += std::min(delta_time, std::max(0.1, active.actual_frame + active.actual_tick));
   }
 
@@ -1967,74 +2103,137 @@ namespace cse
     if (active.accumulator >= active.actual_tick)
     {
       active.accumulator -= active.actual_tick;
+      ++active.tick_batch;
       return true;
     }
+    if (active.tick_batch > 0) sample(active.tick_spread, active.time, active.tick_batch);
+    active.tick_batch = 0;
     return false;
   }
 
   bool game::ready()
   {
     time();
-    static double deadline{};
-    if (active.time - deadline >= active.actual_frame)
+    if (active.time - active.frame_deadline >= active.actual_frame)
     {
-      deadline += active.actual_frame;
-      if (active.time - deadline >= active.actual_frame) deadline = active.time;
+      active.frame_deadline += active.actual_frame;
+      if (active.time - active.frame_deadline >= active.actual_frame) active.frame_deadline = active.time;
+      sample(active.frame_spread, active.time, 1);
       active.alpha = active.accumulator / active.actual_tick;
       return true;
     }
     return false;
   }
 
+  void game::pace()
+  {
+    if (!active.pace || !active.simulation_time || (active.headless.enabled && active.headless.unthrottled)) return;
+    static constexpr double spin{0.0002};
+    const auto tick_deadline{active.simulation_time.value() + active.actual_tick - active.accumulator};
+    const auto frame_deadline{active.frame_deadline + active.actual_frame};
+    const auto deadline{std::min(tick_deadline, frame_deadline)};
+    time();
+    if (const auto remaining{deadline - active.time - spin}; remaining > 0.0)
+      SDL_DelayPrecise(static_cast<Uint64>(remaining * 1e9));
+    while (clock() < deadline) continue;
+  }
+
   void game::tps()
   {
-    static std::optional<double> start{};
-    static std::optional<double> deadline{};
-    static double accumulator{};
-    static unsigned int count{};
-    if (!start)
+    auto &meter{active.tick_meter};
+    const auto now{clock()};
+    if (!meter.start)
     {
-      start = static_cast<double>(SDL_GetTicksNS()) / 1e9;
-      if (!deadline) deadline = active.time;
+      meter.start = now;
+      if (!meter.deadline) meter.deadline = now;
       return;
     }
 
-    count++;
-    accumulator += (static_cast<double>(SDL_GetTicksNS()) / 1e9) - start.value();
-    if (const auto span{active.time - deadline.value()}; span >= 1.0)
+    meter.count++;
+    meter.accumulator += now - meter.start.value();
+    if (const auto span{now - meter.deadline.value()}; span >= 1.0)
     {
-      active.tick.count = static_cast<unsigned int>(std::llround(count / span));
-      active.tick.average = (accumulator / count) * 1000.0;
-      deadline = active.time;
-      accumulator = 0.0;
-      count = 0;
+      active.tick.count = static_cast<unsigned int>(std::llround(meter.count / span));
+      active.tick.average = (meter.accumulator / meter.count) * 1000.0;
+      active.tick.jitter = deviation(active.tick_spread);
+      active.timing.synchronize = measure(active.profile.synchronize);
+      active.timing.event = measure(active.profile.event);
+      active.timing.simulate = measure(active.profile.simulate);
+      active.timing.collide = measure(active.profile.collide);
+      active.profile.synchronize.clear();
+      active.profile.event.clear();
+      active.profile.simulate.clear();
+      active.profile.collide.clear();
+      meter.deadline = now;
+      meter.accumulator = 0.0;
+      meter.count = 0;
     }
-    start.reset();
+    meter.start.reset();
   }
 
   void game::fps()
   {
-    static std::optional<double> start{};
-    static std::optional<double> deadline{};
-    static double accumulator{};
-    static unsigned int count{};
-    if (!start)
+    auto &meter{active.frame_meter};
+    const auto now{clock()};
+    if (!meter.start)
     {
-      start = static_cast<double>(SDL_GetTicksNS()) / 1e9;
-      if (!deadline) deadline = active.time;
+      meter.start = now;
+      if (!meter.deadline) meter.deadline = now;
       return;
     }
 
-    count++;
-    accumulator += (static_cast<double>(SDL_GetTicksNS()) / 1e9) - start.value();
-    if (const auto span{active.time - deadline.value()}; span >= 1.0)
+    meter.count++;
+    meter.accumulator += now - meter.start.value();
+    if (const auto span{now - meter.deadline.value()}; span >= 1.0)
+    {
+      active.frame.count = static_cast<unsigned int>(std::llround(meter.count / span));
+      active.frame.average = (meter.accumulator / meter.count) * 1000.0;
+      active.frame.jitter = deviation(active.frame_spread);
+      active.timing.prepare = measure(active.profile.prepare);
+      active.timing.upload = measure(active.profile.upload);
+      active.timing.submit = measure(active.profile.submit);
+      active.timing.mix = measure(active.profile.mix);
+      active.profile.prepare.clear();
+      active.profile.upload.clear();
+      active.profile.submit.clear();
+      active.profile.mix.clear();
+      meter.deadline = now;
+      meter.accumulator = 0.0;
+      meter.count = 0;
+    }
+    meter.start.reset();
+  }
+
+  help::game::latency game::measure(const help::histogram &histogram)
+  {
+    return {histogram.percentile(0.50) * 1000.0, histogram.percentile(0.95) * 1000.0,
+            histogram.percentile(0.99) * 1000.0, histogram.maximum() * 1000.0};
+  }
+
+  void game::sample(help::game::active::spread &spread, const double now, const unsigned int steps)
+  {
+    if (spread.last)
+    {
+      const auto interval{(now - spread.last.value()) / static_cast<double>(steps)};
+      spread.sum += interval;
+      spread.squares += interval * interval;
+      ++spread.count;
+    }
+    spread.last = now;
+  }
+
+  double game::deviation(help::game::active::spread &spread)
+  {
+    double result{};
+    if (spread.count > 1)
     {
-      active.frame.count = static_cast<unsigned int>(std::llround(count / span));
-      active.frame.average = (accumulator / count) * 1000.0;
-      deadline = active.time;
-      accumulator = 0.0;
-      count = 0;
+      const auto count{static_cast<double>(spread.count)};
+      const auto mean{spread.sum / count};
+      result = std::sqrt(std::max(0.0, (spread.squares / count) - (mean * mean))) * 1000.0;
     }
-    start.reset();
+    spread.sum = 0.0;
+    spread.squares = 0.0;
+    spread.count = 0;
+    return result;
   }
 }
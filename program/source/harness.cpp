@@ -0,0 +1,80 @@
+#include "harness.hpp"
+
+#include <array>
+#include <memory>
+#include <utility>
+
+#include "game.hpp"
+#include "scene.hpp"
+
+namespace cse::help
+{
+  void harness::prepare(cse::scene &scene) { scene.prepare(); }
+
+  void harness::create(cse::scene &scene) { scene.create(); }
+
+  void harness::synchronize(cse::scene &scene) { scene.synchronize(); }
+
+  void harness::simulate(cse::scene &scene, const double tick) { scene.simulate(tick); }
+
+  void harness::destroy(cse::scene &scene) { scene.destroy(); }
+
+  void harness::clean(cse::scene &scene) { scene.clean(); }
+
+  double harness::tick(const cse::game &game) { return game.active.actual_tick; }
+
+  void harness::blend(cse::game &game, const double alpha) { game.active.alpha = alpha; }
+
+  std::shared_ptr<cse::scene> harness::attach(cse::game &game, std::shared_ptr<cse::scene> scene)
+  { return std::exchange(game.active.scene, std::move(scene)); }
+
+  void harness::render(cse::scene &scene, cse::game &game)
+  { scene.active.render(game.active, game.active.aspect.ratio, game.active.alpha); }
+
+  void harness::order(cse::scene &scene) { scene.active.generate_simulation_order(); }
+
+  void harness::contacts(cse::scene &scene, cse::game &game)
+  { scene.active.generate_contacts(game.active.worker, scene.previous); }
+
+  void harness::graphics(cse::scene &scene, const cse::game &game)
+  { scene.active.generate_graphics_order(game.active.alpha); }
+
+  void harness::sequence(cse::game &game) { game.active.generate_simulation_order(); }
+
+  void harness::pool(cse::game &game) { game.active.generate_pool(); }
+
+  void harness::layers(cse::game &game) { game.active.generate_graphics_order(); }
+
+  void harness::frustum(cse::game &game) { game.active.generate_frustum(); }
+
+  void harness::text(cse::game &game, const cse::scene &scene)
+  { game.active.generate_text(scene.active.object_graphics_order, scene.active.transforms); }
+
+  void harness::lights(cse::game &game, const cse::scene &scene)
+  { game.active.generate_lights(scene.active.light_graphics_order); }
+
+  void harness::occluders(cse::game &game, const cse::scene &scene)
+  { game.active.generate_occluders(scene.active.object_graphics_order, scene.active.transforms); }
+
+  void harness::objects(cse::game &game, const cse::scene &scene)
+  { game.active.generate_objects(scene.active.object_graphics_order, scene.active.transforms); }
+
+  void harness::interfaces(cse::game &game) { game.active.generate_interfaces(); }
+
+  harness::occupancy harness::measure(const cse::scene &scene)
+  {
+    occupancy result{.shift = scene.active.contact_shift, .entries = scene.active.contact_total};
+    for (const auto *grid : std::array{&scene.active.contact_grid, &scene.active.contact_fixed})
+    {
+      result.slots += grid->size();
+      result.buckets += grid->bucket_count();
+      for (const auto &[key, bucket] : *grid)
+        if (!bucket.members.empty())
+        {
+          ++result.cells;
+          result.members += bucket.members.size();
+        }
+    }
+    return result;
+  }
+}
@@ -0,0 +1,50 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace cse::help
+{
+  void histogram::record(const double seconds) noexcept
+  {
+    ++counts.at(bucket(seconds));
+    ++total;
+    peak = std::max(peak, seconds);
+  }
+
+  double histogram::percentile(const double fraction) const noexcept
+  {
+    if (total == 0) return 0.0;
+    const auto rank{std::ceil(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total))};
+    const auto wanted{std::max<std::uint64_t>(1, static_cast<std::uint64_t>(rank))};
+    std::uint64_t seen{};
+    for (std::size_t index{}; index < buckets; ++index)
+      if (seen += counts.at(index); seen >= wanted) return std::min(edge(index), peak);
+    return peak;
+  }
+
+  double histogram::maximum() const noexcept { return peak; }
+
+  std::uint64_t histogram::count() const noexcept { return total; }
+
+  void histogram::clear() noexcept
+  {
+    counts.fill(0);
+    total = 0;
+    peak = 0.0;
+  }
+
+  std::size_t histogram::bucket(const double seconds) noexcept
+  {
+    if (!(seconds >= origin)) return 0;
+    const auto index{1.0 + std::floor(std::log2(seconds / origin) * static_cast<double>(divisions))};
+    return static_cast<std::size_t>(std::min(index, static_cast<double>(buckets - 1)));
+  }
+
+  double histogram::edge(const std::size_t index) noexcept
+  {
+    return origin * std::exp2(static_cast<double>(index) / static_cast<double>(divisions));
+  }
+}
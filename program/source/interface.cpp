@@ -3,10 +3,8 @@
 #include <cmath>
 
 #include "SDL3/SDL_events.h"
-#include "glm/ext/matrix_double4x4.hpp"
-#include "glm/ext/matrix_transform.hpp"
 #include "glm/ext/vector_double2.hpp"
-#include "glm/trigonometric.hpp"
+#include "glm/ext/vector_double3.hpp"
 
 #include "core.hpp"
 #include "exception.hpp"
@@ -19,54 +17,24 @@ namespace cse::help::interface
   active::active(const temporal<glm::dvec2> &translation_, const temporal<double> &rotation_,
                  const temporal<glm::dvec2> &scale_, const bool interactable_, const interface::texture &texture_,
                  const interface::text &text_, const interface::priority &priority_)
-    : translation{translation_}, rotation{rotation_}, scale{scale_}, interactable{interactable_}, texture{texture_},
-      text{text_}, priority{priority_} {};
+    : state{.translation = translation_, .rotation = rotation_, .scale = scale_, .interactable = interactable_,
+            .texture = texture_, .text = text_, .priority = priority_} {};
 
   void active::synchronize(previous &last)
   {
-    last.translation = translation;
-    last.rotation = rotation;
-    last.scale = scale;
-    last.interactable = interactable;
-    last.texture = texture;
-    last.text = text;
-    last.priority = priority;
-
-    last.target = target;
-    last.timer = timer;
-    last.mixer = mixer;
-    last.phase = phase;
-
-    for (auto &[name, sound] : mixer.sounds)
-    {
-      sound.speed.instant = false;
-      sound.volume.instant = false;
-    }
-    for (auto &[name, music] : mixer.musics)
-    {
-      music.speed.instant = false;
-      music.volume.instant = false;
-    }
-    translation.instant = false;
-    rotation.instant = false;
-    scale.instant = false;
-    texture.playback.speed.instant = false;
-    texture.color.tint.instant = false;
-    texture.color.alpha.instant = false;
-    text.playback.speed.instant = false;
-    text.align.horizontal.spacing.instant = false;
-    text.align.vertical.spacing.instant = false;
-    text.align.offset.instant = false;
-    text.scale.instant = false;
-    text.color.tint.instant = false;
-    text.color.alpha.instant = false;
+    static_cast<state &>(last) = *this;
+
+    mixer.settle();
+    help::settle(translation, rotation, scale, texture.playback.speed, texture.color.tint, texture.color.alpha,
+                 text.playback.speed, text.align.horizontal.spacing, text.align.vertical.spacing, text.align.offset,
+                 text.scale, text.color.tint, text.color.alpha);
     target.released = {};
     target.clicked = {};
   }
 
-  glm::dmat4 active::calculate_model_matrix(const previous &last, const unsigned int frame_width,
-                                            const unsigned int frame_height, const glm::dvec2 &pivot,
-                                            const double alpha) const
+  transform::placement active::calculate_model_placement(const previous &last, const unsigned int frame_width,
+                                                         const unsigned int frame_height, const glm::dvec2 &pivot,
+                                                         const double alpha) const
   {
     auto interpolated_translation = translation.interpolated(last.translation, alpha);
     auto interpolated_rotation = rotation.interpolated(last.rotation, alpha);
@@ -75,32 +43,24 @@ namespace cse::help::interface
     const auto scale_y{std::floor(interpolated_scale.y + 0.5)};
     const int steps{static_cast<int>(std::floor(interpolated_rotation + 0.5))};
     const auto offset{transform::anchor(steps, texture.flip, scale_x, scale_y, frame_width, frame_height, pivot)};
-    auto model_matrix{glm::dmat4(1.0)};
-    model_matrix = glm::translate(model_matrix, {std::floor(interpolated_translation.x + 0.5) + offset.x,
-                                                 std::floor(interpolated_translation.y + 0.5) + offset.y, 0.0});
-    model_matrix =
-      glm::rotate(model_matrix, glm::radians(std::floor(interpolated_rotation + 0.5) * -90.0), {0.0, 0.0, 1.0});
-    model_matrix = glm::scale(model_matrix, {scale_x * static_cast<double>(frame_width) / 2.0,
-                                             scale_y * static_cast<double>(frame_height) / 2.0, 1.0});
-    return model_matrix;
+    return transform::place(
+      {std::floor(interpolated_translation.x + 0.5) + offset.x, std::floor(interpolated_translation.y + 0.5) + offset.y,
+       0.0},
+      steps, {}, {scale_x * static_cast<double>(frame_width), scale_y * static_cast<double>(frame_height)});
   }
 
-  glm::dmat4 active::calculate_text_matrix(const previous &last, const double width, const double height,
-                                           const glm::dvec2 &offset, const double alpha) const
+  transform::placement active::calculate_text_placement(const previous &last, const double width, const double height,
+                                                        const glm::dvec2 &offset, const double alpha) const
   {
     auto interpolated_translation = translation.interpolated(last.translation, alpha);
     auto interpolated_rotation = rotation.interpolated(last.rotation, alpha);
     const auto pixel_width{std::floor(width + 0.5)};
     const auto pixel_height{std::floor(height + 0.5)};
-    auto model_matrix{glm::dmat4(1.0)};
-    model_matrix = glm::translate(
-      model_matrix, {std::floor(interpolated_translation.x + 0.5), std::floor(interpolated_translation.y + 0.5), 0.0});
-    model_matrix =
-      glm::rotate(model_matrix, glm::radians(std::floor(interpolated_rotation + 0.5) * -90.0), {0.0, 0.0, 1.0});
-    model_matrix = glm::translate(
-      model_matrix, {transform::snap_x(offset.x, pixel_width), transform::snap_y(offset.y, pixel_height), 0.0});
-    model_matrix = glm::scale(model_matrix, {pixel_width / 2.0, pixel_height / 2.0, 1.0});
-    return model_matrix;
+    return transform::place(
+      {std::floor(interpolated_translation.x + 0.5), std::floor(interpolated_translation.y + 0.5), 0.0},
+      static_cast<int>(std::floor(interpolated_rotation + 0.5)),
+      {transform::snap_x(offset.x, pixel_width), transform::snap_y(offset.y, pixel_height)},
+      {pixel_width, pixel_height});
   }
 
   void active::animate(const double tick)
@@ -17,40 +17,16 @@ namespace cse::help::light
 {
   active::active(const temporal<glm::dvec3> &translation_, const temporal<glm::dvec2> &rotation_,
                  const light::illumination &illumination_, const light::shadow &shadow_, const int priority_)
-    : translation{translation_}, rotation{rotation_}, illumination{illumination_}, shadow{shadow_},
-      priority{priority_} {};
+    : state{.translation = translation_, .rotation = rotation_, .illumination = illumination_, .shadow = shadow_,
+            .priority = priority_} {};
 
   void active::synchronize(previous &last)
   {
-    last.translation = translation;
-    last.rotation = rotation;
-    last.illumination = illumination;
-    last.shadow = shadow;
-    last.priority = priority;
+    static_cast<state &>(last) = *this;
 
-    last.timer = timer;
-    last.mixer = mixer;
-    last.phase = phase;
-
-    for (auto &[name, sound] : mixer.sounds)
-    {
-      sound.speed.instant = false;
-      sound.volume.instant = false;
-    }
-    for (auto &[name, music] : mixer.musics)
-    {
-      music.speed.instant = false;
-      music.volume.instant = false;
-    }
-    translation.instant = false;
-    rotation.instant = false;
-    illumination.brightness.instant = false;
-    illumination.penetration.instant = false;
-    illumination.shape.range.instant = false;
-    illumination.shape.angle.instant = false;
-    illumination.shape.feather.instant = false;
-    shadow.darkness.instant = false;
-    shadow.softness.instant = false;
+    mixer.settle();
+    help::settle(translation, rotation, illumination.brightness, illumination.penetration, illumination.shape.range,
+                 illumination.shape.angle, illumination.shape.feather, shadow.darkness, shadow.softness);
   }
 
   glm::dvec3 active::calculate_direction(const previous &last, const double alpha) const
@@ -133,6 +133,12 @@ namespace cse
     handle = std::move(fresh);
   }
 
+  lexeme &lexeme::operator=(const lexeme &other)
+  {
+    if (handle != other.handle) handle = other.handle;
+    return *this;
+  }
+
   bool lexeme::operator==(const char *other) const { return string() == (other ? other : ""); }
 
   bool lexeme::operator==(const std::string &other) const { return string() == other; }
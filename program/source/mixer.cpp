@@ -12,7 +12,7 @@ namespace cse::help
 {
   mixer &mixer::operator=(const mixer &other)
   {
-    if (this == &other) return *this;
+    if (this == &other || revision == other.revision) return *this;
     const auto reconcile{[](const auto &source, auto &target)
                          {
                            std::erase_if(target, [&source](const auto &item) { return !source.contains(item.first); });
@@ -24,6 +24,7 @@ namespace cse::help
                          }};
     reconcile(other.sounds, sounds);
     reconcile(other.musics, musics);
+    revision = other.revision;
     return *this;
   }
 
@@ -38,8 +39,7 @@ namespace cse::help
 
   void mixer::remove(const name name)
   {
-    sounds.erase(name);
-    musics.erase(name);
+    if (sounds.erase(name) + musics.erase(name) != 0) ++revision;
   }
 
   void mixer::remove(std::initializer_list<name> names)
@@ -49,8 +49,10 @@ namespace cse::help
 
   void mixer::clear() noexcept
   {
+    if (sounds.empty() && musics.empty()) return;
     sounds.clear();
     musics.clear();
+    ++revision;
   }
 
   void mixer::simulate(const double tick)
@@ -71,7 +73,17 @@ namespace cse::help
                           track.elapsed.tick = duration;
                       }
                     }};
+    if (sounds.empty() && musics.empty()) return;
     step(sounds);
     step(musics);
+    ++revision;
+  }
+
+  void mixer::settle() noexcept
+  {
+    if (sounds.empty() && musics.empty()) return;
+    ++revision;
+    for (auto &[name, track] : sounds) help::settle(track.speed, track.volume);
+    for (auto &[name, track] : musics) help::settle(track.speed, track.volume);
   }
 }
@@ -0,0 +1,35 @@
+#include "radix.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cse::help
+{
+  void radix_sort(std::vector<std::uint64_t> &keys, std::vector<std::uint64_t> &scratch)
+  {
+    constexpr std::size_t width{8};
+    constexpr std::size_t digits{64 / width};
+    constexpr std::uint64_t mask{(std::uint64_t{1} << width) - 1};
+    if (keys.size() < 2) return;
+    std::array<std::array<std::size_t, std::size_t{1} << width>, digits> counts{};
+    for (const auto key : keys)
+      for (std::size_t digit{}; digit < digits; ++digit) ++counts.at(digit).at((key >> (digit * width)) & mask);
+    scratch.resize(keys.size());
+    for (std::size_t digit{}; digit < digits; ++digit)
+    {
+      auto &count{counts.at(digit)};
+      if (count.at((keys.front() >> (digit * width)) & mask) == keys.size()) continue;
+      std::size_t offset{};
+      for (auto &entry : count)
+      {
+        const auto amount{entry};
+        entry = offset;
+        offset += amount;
+      }
+      for (const auto key : keys) scratch.at(count.at((key >> (digit * width)) & mask)++) = key;
+      keys.swap(scratch);
+    }
+  }
+}
@@ -1,13 +1,16 @@
 #include "scene.hpp"
 
 #include <algorithm>
-#include <bit>
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -27,14 +30,16 @@
 #include "name.hpp"
 #include "numeric.hpp"
 #include "object.hpp"
+#include "trace.hpp"
+#include "worker.hpp"
 
 namespace cse::help::scene
 {
   std::size_t active::contact_key::hash::operator()(const contact_key &key) const
   {
-    std::size_t seed{std::hash<std::size_t>{}(key.self)};
+    std::size_t seed{std::hash<std::uint64_t>{}(key.self)};
     const auto mix{[&seed](std::size_t value) { seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6u) + (seed >> 2u); }};
-    mix(std::hash<std::size_t>{}(key.target));
+    mix(std::hash<std::uint64_t>{}(key.target));
     mix(std::hash<std::uint64_t>{}(key.self_hitbox));
     mix(std::hash<std::uint64_t>{}(key.target_hitbox));
     return seed;
@@ -47,21 +52,27 @@ namespace cse::help::scene
     last.objects = objects;
     last.lights = lights;
     last.contacts.swap(contacts);
+    last.began.swap(began);
+    last.persisted.swap(persisted);
+    last.ended.swap(ended);
     contacts.clear();
+    began.clear();
+    persisted.clear();
+    ended.clear();
+    if (contact_carried)
+    {
+      contact_keys.clear();
+      contact_lookup.clear();
+      contact_owners.clear();
+      contact_offsets.clear();
+      contact_positions.clear();
+    }
+    contact_carried = true;
     last.timer = timer;
     last.mixer = mixer;
     last.phase = phase;
 
-    for (auto &[name, sound] : mixer.sounds)
-    {
-      sound.speed.instant = false;
-      sound.volume.instant = false;
-    }
-    for (auto &[name, music] : mixer.musics)
-    {
-      music.speed.instant = false;
-      music.volume.instant = false;
-    }
+    mixer.settle();
   }
 
   void active::render(game::active &game_active, const double aspect, const double alpha)
@@ -69,10 +80,10 @@ namespace cse::help::scene
     generate_graphics_order(alpha);
     game_active.graphics_object.world = camera->render(aspect, alpha);
     game_active.generate_frustum();
-    game_active.generate_text(object_graphics_order);
+    game_active.generate_text(object_graphics_order, transforms);
     game_active.generate_lights(light_graphics_order);
-    game_active.generate_occluders(object_graphics_order);
-    game_active.generate_objects(object_graphics_order);
+    game_active.generate_occluders(object_graphics_order, transforms);
+    game_active.generate_objects(object_graphics_order, transforms);
   }
 
   void active::generate_simulation_order()
@@ -96,6 +107,8 @@ namespace cse::help::scene
                       {
                         if (left->active.priority.simulation != right->active.priority.simulation)
                           return left->active.priority.simulation > right->active.priority.simulation;
+                        if (left->active.priority.parallel != right->active.priority.parallel)
+                          return left->active.priority.parallel;
                         return left->name.identifier() < right->name.identifier();
                       });
 
@@ -111,10 +124,38 @@ namespace cse::help::scene
                       });
   }
 
-  void active::generate_contacts()
+  void active::generate_contacts(help::worker &worker, const previous &last)
   {
+    CSE_TRACE_ZONE("scene::generate_contacts");
+    if (!contact_carried)
+    {
+      contact_keys.clear();
+      contact_lookup.clear();
+    }
+    contact_keys.swap(contact_keys_previous);
+    contact_lookup.swap(contact_lookup_previous);
     contacts.clear();
-    if (objects.empty()) return;
+    contact_keys.clear();
+    contact_lookup.clear();
+    contact_owners.clear();
+    contact_offsets.clear();
+    contact_positions.clear();
+    contact_carried = false;
+    const auto reset{[&]()
+                     {
+                       contact_members.clear();
+                       contact_bodies.clear();
+                       contact_grid.clear();
+                       contact_fixed.clear();
+                       contact_groups.clear();
+                       contact_shift = -1;
+                     }};
+    if (objects.empty())
+    {
+      reset();
+      generate_changes(last);
+      return;
+    }
 
     cse::collider layer_union{};
     cse::collider target_union{};
@@ -123,239 +164,646 @@ namespace cse::help::scene
       layer_union = layer_union | object->active.collider.self;
       target_union = target_union | object->active.collider.target;
     }
-    if (layer_union.empty() || target_union.empty()) return;
+    if (layer_union.empty())
+    {
+      reset();
+      generate_changes(last);
+      return;
+    }
+
+    bool full{contact_layers != layer_union || contact_targets != target_union ||
+              contact_members.size() != objects.size()};
+    for (std::size_t index{}; !full && index < objects.size(); ++index)
+      full = contact_members.at(index) != objects.at(index).get();
+    if (full)
+    {
+      contact_members.clear();
+      for (contact_members.reserve(objects.size()); const auto &object : objects)
+        contact_members.push_back(object.get());
+      contact_bodies.assign(objects.size(), {});
+      contact_groups.clear();
+      contact_layers = layer_union;
+      contact_targets = target_union;
+      contact_extents = 0;
+      contact_count = 0;
+      contact_spread = 0;
+      contact_total = 0;
+    }
 
-    auto &entries{contact_entries};
-    auto &boxes{contact_hitboxes};
-    entries.clear();
-    boxes.clear();
-    bool duplicates{};
+    bool regrouped{full};
+    const auto intern{[&](const cse::collider &layer, const cse::collider &target)
+                      {
+                        for (std::size_t index{}; index < contact_groups.size(); ++index)
+                          if (contact_groups.at(index).layer == layer && contact_groups.at(index).target == target)
+                            return static_cast<std::uint32_t>(index);
+                        contact_groups.push_back({layer, target, {}, {}});
+                        regrouped = true;
+                        return static_cast<std::uint32_t>(contact_groups.size() - 1);
+                      }};
+    auto &moved{contact_moved};
+    moved.clear();
     for (std::size_t index{}; index < objects.size(); ++index)
     {
       const auto &object{objects.at(index)};
+      auto &body{contact_bodies.at(index)};
       const auto &filter{object->active.collider};
-      if (none(filter.self, target_union) && none(filter.target, layer_union)) continue;
+      const auto &translation{object->active.translation.value};
+      const auto swept{filter.continuous && !object->active.translation.instant};
+      const auto &origin{swept ? object->previous.translation.value : translation};
+      const auto boxes{object->hitboxes()};
+      if (!full && body.revision == object->bounds.revision && body.layer == filter.self &&
+          body.target == filter.target && body.continuous == swept && body.origin == origin &&
+          body.resting == filter.fixed)
+        continue;
+
+      body.revision = object->bounds.revision;
+      body.layer = filter.self;
+      body.target = filter.target;
+      body.group = intern(filter.self, filter.target);
+      body.continuous = swept;
+      body.origin = origin;
+      body.resting = filter.fixed;
+      for (const auto &entry : body.entries)
+      {
+        const auto extent{static_cast<std::int64_t>(entry.right) - entry.left + entry.top - entry.bottom};
+        if (body.counted) contact_extents -= extent;
+        contact_spread -= extent;
+      }
+      if (body.counted) contact_count -= body.entries.size();
+      contact_total -= body.entries.size();
+      body.entries.clear();
+      body.boxes.clear();
+      body.origins.clear();
+      body.counted = !none(filter.self, target_union) || !none(filter.target, layer_union);
+      moved.push_back(static_cast<std::uint32_t>(index));
+
+      if (!body.counted && filter.self.empty()) continue;
       const auto sources{collision::hitboxes(object.get())};
       if (sources.empty()) continue;
-      const auto depth{collision::quantize(std::floor(object->active.translation.value.z + 0.5))};
-      for (auto source{sources.begin()}; source != sources.end(); ++source)
+      const auto depth{collision::quantize(std::floor(translation.z + 0.5))};
+      for (std::size_t position{}; position < boxes.size(); ++position)
       {
-        if (!duplicates)
-          for (auto other{std::next(source)}; other != sources.end(); ++other)
-            if (source->name == other->name) duplicates = true;
-        const auto box{collision::bounds(object.get(), *source)};
-        const auto left{collision::quantize(box.left)};
-        const auto bottom{collision::quantize(box.bottom)};
-        const auto right{collision::quantize(box.right)};
-        const auto top{collision::quantize(box.top)};
+        const auto &box{boxes[position]};
+        if (box.right <= box.left || box.top <= box.bottom) continue;
+        auto start{box};
+        if (swept)
+          start = collision::bounds(object.get(), sources[position], origin, object->previous.rotation.value,
+                                    object->previous.scale.value);
+        const auto left{collision::quantize(std::min(box.left, start.left))};
+        const auto bottom{collision::quantize(std::min(box.bottom, start.bottom))};
+        const auto right{collision::quantize(std::max(box.right, start.right))};
+        const auto top{collision::quantize(std::max(box.top, start.top))};
         if (right <= left || top <= bottom) continue;
-        entries.push_back({left, bottom, right, top, depth, static_cast<std::uint32_t>(index), filter.self.bits(),
-                           filter.target.bits()});
-        boxes.push_back(box);
+        body.entries.push_back({left, bottom, right, top, depth, static_cast<std::uint32_t>(index), body.group});
+        body.boxes.push_back(box);
+        if (swept) body.origins.push_back(start);
+        const auto extent{static_cast<std::int64_t>(right) - left + top - bottom};
+        if (body.counted) contact_extents += extent;
+        contact_spread += extent;
       }
+      if (body.counted) contact_count += body.entries.size();
+      contact_total += body.entries.size();
     }
-    if (entries.size() < 2) return;
+    if (regrouped)
+      for (auto &group : contact_groups)
+      {
+        group.matches.clear();
+        group.partners.clear();
+        for (std::size_t index{}; index < contact_groups.size(); ++index)
+        {
+          const auto &other{contact_groups.at(index)};
+          const auto forward{group.target.intersects(other.layer)};
+          if (forward) group.matches.push_back(static_cast<std::uint32_t>(index));
+          if (forward || other.target.intersects(group.layer))
+            group.partners.push_back(static_cast<std::uint32_t>(index));
+        }
+      }
 
-    contact_lookup.clear();
-    const auto record{[&](contact &&value, const std::size_t self_index, const std::size_t target_index)
+    const auto derive{[](const std::int64_t extents, const std::size_t count)
                       {
-                        if (!duplicates)
-                        {
-                          contacts.push_back(std::move(value));
-                          return;
-                        }
-                        const contact_key key{self_index, target_index, value.self.hitbox.name.identifier(),
-                                              value.target.hitbox.name.identifier()};
-                        const auto found{contact_lookup.find(key)};
-                        if (found == contact_lookup.end())
+                        const auto average{
+                          std::max(1.0, static_cast<double>(extents) / static_cast<double>(count * 2))};
+                        const auto span{std::lround(std::log2(average * cell_ratio))};
+                        return static_cast<std::int32_t>(std::clamp(span, 0l, 30l));
+                      }};
+    auto shift{contact_shift};
+    auto wanted{shift};
+    if (contact_count > 0)
+      wanted = derive(contact_extents, contact_count);
+    else if (contact_total > 0)
+      wanted = derive(contact_spread, contact_total);
+    if (regrouped || shift < 0 || std::abs(wanted - shift) > 1) shift = wanted;
+
+    const auto cover{[&](const collision::entry &entry, const std::uint32_t group, const auto &visit)
+                     {
+                       for (auto y{entry.bottom >> shift}; y <= (entry.top - 1) >> shift; ++y)
+                         for (auto x{entry.left >> shift}; x <= (entry.right - 1) >> shift; ++x)
+                           visit(collision::area{entry.z, x, y, group});
+                     }};
+    const auto awaken{[&](const collision::bucket &bucket)
+                      {
+                        for (const auto watcher : bucket.watchers) contact_bodies.at(watcher).dirty = true;
+                      }};
+    const auto detach{[&](const std::uint32_t index)
+                      {
+                        auto &body{contact_bodies.at(index)};
+                        auto &home{body.settled ? contact_fixed : contact_grid};
+                        for (const auto &key : body.stored)
+                          if (const auto found{home.find(key)}; found != home.end())
+                          {
+                            auto &members{found->second.members};
+                            const auto first{std::ranges::lower_bound(members, collision::held{index, 0})};
+                            const auto last{std::ranges::lower_bound(members, collision::held{index + 1, 0})};
+                            if (first == last) continue;
+                            members.erase(first, last);
+                            awaken(found->second);
+                          }
+                        const auto forget{[index](auto &grid, const std::vector<collision::area> &keys)
+                                          {
+                                            for (const auto &key : keys)
+                                              if (const auto found{grid.find(key)}; found != grid.end())
+                                                std::erase(found->second.watchers, index);
+                                          }};
+                        forget(contact_grid, body.watched);
+                        forget(contact_fixed, body.observed);
+                        body.stored.clear();
+                        body.watched.clear();
+                        body.observed.clear();
+                      }};
+    const auto attach{[&](const std::uint32_t index)
+                      {
+                        auto &body{contact_bodies.at(index)};
+                        body.settled = body.resting;
+                        body.dirty = !body.resting;
+                        if (body.resting) body.records.clear();
+                        auto &home{body.resting ? contact_fixed : contact_grid};
+                        for (std::size_t position{}; position < body.entries.size(); ++position)
                         {
-                          contact_lookup.emplace(key, contacts.size());
-                          contacts.push_back(std::move(value));
-                          return;
+                          const auto &entry{body.entries.at(position)};
+                          const collision::held member{index, static_cast<std::uint32_t>(position)};
+                          const auto &group{contact_groups.at(entry.group)};
+                          if (body.resting || !group.layer.empty())
+                            cover(entry, entry.group,
+                                  [&](const collision::area &key)
+                                  {
+                                    auto &bucket{home[key]};
+                                    bucket.members.insert(std::ranges::upper_bound(bucket.members, member), member);
+                                    awaken(bucket);
+                                    body.stored.push_back(key);
+                                  });
+                          if (body.resting) continue;
+                          for (const auto partner : group.partners)
+                            cover(entry, partner,
+                                  [&](const collision::area &key)
+                                  {
+                                    contact_fixed[key].watchers.push_back(index);
+                                    body.observed.push_back(key);
+                                  });
+                          for (const auto match : group.matches)
+                            cover(entry, match,
+                                  [&](const collision::area &key)
+                                  {
+                                    contact_grid[key].watchers.push_back(index);
+                                    body.watched.push_back(key);
+                                  });
                         }
-                        auto &existing{contacts.at(found->second)};
-                        const double area{std::max(value.overlap.x, 0.0) * std::max(value.overlap.y, 0.0)};
-                        const double kept{std::max(existing.overlap.x, 0.0) * std::max(existing.overlap.y, 0.0)};
-                        if (area > kept) existing = std::move(value);
                       }};
 
-    const auto attempt{[&](const std::size_t first, const std::size_t second)
+    if (regrouped || shift != contact_shift)
+    {
+      contact_shift = shift;
+      contact_grid.clear();
+      contact_fixed.clear();
+      for (auto &body : contact_bodies)
+      {
+        body.stored.clear();
+        body.watched.clear();
+        body.observed.clear();
+      }
+      for (std::size_t index{}; index < contact_bodies.size(); ++index) attach(static_cast<std::uint32_t>(index));
+    }
+    else
+    {
+      for (const auto index : moved) detach(index);
+      for (const auto index : moved) attach(index);
+    }
+    if (contact_grid.size() + contact_fixed.size() > contact_limit)
+    {
+      const auto vacant{[](const auto &item) { return item.second.members.empty() && item.second.watchers.empty(); }};
+      std::erase_if(contact_grid, vacant);
+      std::erase_if(contact_fixed, vacant);
+      contact_limit = std::max(contact_floor, (contact_grid.size() + contact_fixed.size()) * 2);
+    }
+
+    const auto attempt{[&](collision::body &body, const collision::held first, const collision::held second)
                        {
-                         const auto &one{*std::next(entries.begin(), static_cast<std::ptrdiff_t>(first))};
-                         const auto &two{*std::next(entries.begin(), static_cast<std::ptrdiff_t>(second))};
+                         const auto &one{contact_bodies.at(first.object).entries.at(first.entry)};
+                         const auto &two{contact_bodies.at(second.object).entries.at(second.entry)};
                          if (one.object == two.object) return;
-                         const auto forward{(one.target & two.layer) != 0};
-                         const auto backward{(two.target & one.layer) != 0};
+                         const auto &one_group{contact_groups.at(one.group)};
+                         const auto &two_group{contact_groups.at(two.group)};
+                         const auto forward{one_group.target.intersects(two_group.layer)};
+                         const auto backward{two_group.target.intersects(one_group.layer)};
                          if (!forward && !backward) return;
                          if (one.z != two.z) return;
                          if (one.left >= two.right || one.right <= two.left || one.bottom >= two.top ||
                              one.top <= two.bottom)
                            return;
 
-                         const auto &own{*std::next(boxes.begin(), static_cast<std::ptrdiff_t>(first))};
-                         const auto &theirs{*std::next(boxes.begin(), static_cast<std::ptrdiff_t>(second))};
+                         const auto &first_body{contact_bodies.at(first.object)};
+                         const auto &second_body{contact_bodies.at(second.object)};
+                         auto own{first_body.boxes.at(first.entry)};
+                         auto theirs{second_body.boxes.at(second.entry)};
+                         auto impact{1.0};
+                         if (first_body.continuous || second_body.continuous)
+                         {
+                           const auto &own_start{first_body.continuous ? first_body.origins.at(first.entry) : own};
+                           const auto &their_start{second_body.continuous ? second_body.origins.at(second.entry)
+                                                                          : theirs};
+                           const auto time{collision::sweep(own_start, own, their_start, theirs)};
+                           if (!time) return;
+                           impact = *time;
+                           if (!collision::overlaps(own, theirs))
+                           {
+                             own = collision::blend(own_start, own, impact);
+                             theirs = collision::blend(their_start, theirs, impact);
+                           }
+                         }
                          auto *owner{objects.at(one.object).get()};
                          auto *other{objects.at(two.object).get()};
                          if (!forward)
                          {
-                           record(collision::describe(other->name, owner, theirs, own), two.object, one.object);
+                           auto value{collision::describe(other->name, owner, theirs, own)};
+                           value.impact = impact;
+                           body.records.push_back({std::move(value), two.object, one.object});
                            return;
                          }
                          auto primary{collision::describe(owner->name, other, own, theirs)};
+                         primary.impact = impact;
                          if (!backward)
                          {
-                           record(std::move(primary), one.object, two.object);
+                           body.records.push_back({std::move(primary), one.object, two.object});
                            return;
                          }
                          auto mirrored{collision::mirror(primary, other->name, owner)};
-                         record(std::move(primary), one.object, two.object);
-                         record(std::move(mirrored), two.object, one.object);
+                         body.records.push_back({std::move(primary), one.object, two.object});
+                         body.records.push_back({std::move(mirrored), two.object, one.object});
                        }};
 
-    const auto sought{target_union.bits()};
-    const auto present{layer_union.bits()};
+    const auto examine{[&](const std::uint32_t index)
+                       {
+                         auto &body{contact_bodies.at(index)};
+                         body.dirty = false;
+                         body.records.clear();
+                         for (std::size_t position{}; position < body.entries.size(); ++position)
+                         {
+                           const auto &self{body.entries.at(position)};
+                           const collision::held own{index, static_cast<std::uint32_t>(position)};
+                           const auto &group{contact_groups.at(self.group)};
+                           for (const auto match : group.matches)
+                             cover(self, match,
+                                   [&](const collision::area &key)
+                                   {
+                                     const auto found{contact_grid.find(key)};
+                                     if (found == contact_grid.end()) return;
+                                     const auto mutual{contact_groups.at(match).target.intersects(group.layer)};
+                                     for (const auto &member : found->second.members)
+                                     {
+                                       const auto &other{contact_bodies.at(member.object).entries.at(member.entry)};
+                                       if (mutual && member <= own) continue;
+                                       if (std::max(self.left >> shift, other.left >> shift) != key.x) continue;
+                                       if (std::max(self.bottom >> shift, other.bottom >> shift) != key.y) continue;
+                                       attempt(body, own, member);
+                                     }
+                                   });
+                           for (const auto partner : group.partners)
+                             cover(self, partner,
+                                   [&](const collision::area &key)
+                                   {
+                                     const auto found{contact_fixed.find(key)};
+                                     if (found == contact_fixed.end()) return;
+                                     for (const auto &member : found->second.members)
+                                     {
+                                       const auto &other{contact_bodies.at(member.object).entries.at(member.entry)};
+                                       if (std::max(self.left >> shift, other.left >> shift) != key.x) continue;
+                                       if (std::max(self.bottom >> shift, other.bottom >> shift) != key.y) continue;
+                                       attempt(body, own, member);
+                                     }
+                                   });
+                         }
+                       }};
+
+    auto &dirty{contact_dirty};
+    dirty.clear();
+    for (std::size_t index{}; index < contact_bodies.size(); ++index)
+      if (contact_bodies.at(index).dirty) dirty.push_back(static_cast<std::uint32_t>(index));
+    worker.run((dirty.size() + contact_grain - 1) / contact_grain,
+               [&](const std::size_t chunk)
+               {
+                 const auto first{chunk * contact_grain};
+                 const auto last{std::min(dirty.size(), first + contact_grain)};
+                 for (auto position{first}; position < last; ++position) examine(dirty.at(position));
+               });
+
+    const auto record{[&](contact &&value, const std::size_t self_index, const std::size_t target_index)
+                      {
+                        const contact_key key{objects.at(self_index)->name.identifier(),
+                                              objects.at(target_index)->name.identifier(),
+                                              value.self.hitbox.name.identifier(),
+                                              value.target.hitbox.name.identifier()};
+                        const auto found{contact_lookup.find(key)};
+                        if (found == contact_lookup.end())
+                        {
+                          contact_lookup.emplace(key, contacts.size());
+                          contact_keys.push_back(key);
+                          contacts.push_back(std::move(value));
+                          contact_owners.push_back(static_cast<std::uint32_t>(self_index));
+                          return;
+                        }
+                        auto &existing{contacts.at(found->second)};
+                        const double area{std::max(value.overlap.x, 0.0) * std::max(value.overlap.y, 0.0)};
+                        const double kept{std::max(existing.overlap.x, 0.0) * std::max(existing.overlap.y, 0.0)};
+                        if (area > kept) existing = std::move(value);
+                      }};
+    for (const auto &body : contact_bodies)
+      for (const auto &entry : body.records) record(contact{entry.value}, entry.self, entry.target);
+
+    contact_offsets.assign(objects.size() + 1, 0);
+    for (const auto owner : contact_owners) ++contact_offsets.at(owner + 1);
+    for (std::size_t index{}; index < objects.size(); ++index)
+      contact_offsets.at(index + 1) += contact_offsets.at(index);
+    contact_cursor.assign(contact_offsets.begin(), std::prev(contact_offsets.end()));
+    contact_positions.resize(contacts.size());
+    for (std::size_t position{}; position < contact_owners.size(); ++position)
+      contact_positions.at(contact_cursor.at(contact_owners.at(position))++) = static_cast<std::uint32_t>(position);
+    generate_changes(last);
+  }
 
-    std::int64_t extents{};
-    for (const auto &entry : entries)
+  void active::generate_changes(const previous &last)
+  {
+    began.clear();
+    persisted.clear();
+    ended.clear();
+    for (std::size_t position{}; position < contacts.size(); ++position)
     {
-      extents += static_cast<std::int64_t>(entry.right) - entry.left;
-      extents += static_cast<std::int64_t>(entry.top) - entry.bottom;
+      auto &destination{contact_lookup_previous.contains(contact_keys.at(position)) ? persisted : began};
+      destination.push_back(contacts.at(position));
     }
-    const auto average{extents / static_cast<std::int64_t>(entries.size() * 2)};
-    const auto typical{std::max<std::int64_t>(1, (average * 2) - 1)};
-    const auto span{static_cast<std::size_t>(std::bit_width(static_cast<std::uint64_t>(typical)))};
-    const auto shift{static_cast<std::int32_t>(std::min(std::size_t{30}, span))};
+    for (std::size_t position{}; position < contact_keys_previous.size(); ++position)
+    {
+      const auto &key{contact_keys_previous.at(position)};
+      if (contact_lookup.contains(key)) continue;
+      auto &change{ended.emplace_back(last.contacts.at(position))};
+      if (const auto target{objects.find(cse::name{key.target})}; target.get() != change.target.pointer)
+        change.target.pointer = nullptr;
+    }
+  }
 
-    std::size_t insertions{};
-    for (const auto &entry : entries)
+  void active::generate_graphics_order(const double alpha)
+  {
+    CSE_TRACE_ZONE("scene::generate_graphics_order");
+    transforms.gather(objects, alpha);
+    auto camera_translation = camera->active.translation.interpolated(camera->previous.translation, alpha);
+    auto camera_forward = glm::normalize(camera->active.forward.interpolated(camera->previous.forward, alpha));
+    object_keys.clear();
+    object_keys.reserve(objects.size());
+    for (std::size_t slot{}; slot < objects.size(); ++slot)
     {
-      const auto carried{static_cast<std::size_t>(std::popcount(entry.layer & sought))};
-      if (carried == 0) continue;
-      const auto columns{static_cast<std::size_t>(((entry.right - 1) >> shift) - (entry.left >> shift) + 1)};
-      const auto rows{static_cast<std::size_t>(((entry.top - 1) >> shift) - (entry.bottom >> shift) + 1)};
-      insertions += carried * columns * rows;
+      const auto &object{objects.at(slot)};
+      const auto position{transforms.translation.at(slot)};
+      const auto depth{(std::floor(position.z + 0.5) - camera_translation.z) * camera_forward.z};
+      object_keys.push_back({std::llround(-depth / depth_step), object->active.priority.rendering,
+                             reinterpret_cast<std::uintptr_t>(object->active.texture.source.image.data.data()),
+                             object->name.identifier()});
     }
-    if (insertions == 0) return;
-    const auto buckets{std::bit_ceil(std::max<std::size_t>(16, insertions))};
-    const auto bucket{[&](const std::int32_t z, const std::int32_t x, const std::int32_t y, const int bit)
-                      { return collision::cell(z, x, y, bit) & (buckets - 1); }};
-
-    auto &counts{contact_counts};
-    auto &cursor{contact_cursor};
-    auto &table{contact_table};
-    counts.assign(buckets + 1, 0);
-    for (const auto &entry : entries)
+
+    const auto before{[this](const cse::object *left, const cse::object *right)
+                      { return object_keys.at(left->slot) < object_keys.at(right->slot); }};
+    bool kept{object_members.size() == objects.size()};
+    for (std::size_t slot{}; kept && slot < objects.size(); ++slot)
+      kept = object_members.at(slot) == objects.at(slot).get();
+    auto repaired{kept};
+    if (!kept)
     {
-      const auto first_x{entry.left >> shift};
-      const auto last_x{(entry.right - 1) >> shift};
-      const auto first_y{entry.bottom >> shift};
-      const auto last_y{(entry.top - 1) >> shift};
-      for (auto bits{entry.layer & sought}; bits != 0; bits &= bits - 1)
+      object_members.clear();
+      object_graphics_order.clear();
+      object_members.reserve(objects.size());
+      object_graphics_order.reserve(objects.size());
+      for (const auto &object : objects)
       {
-        const auto bit{std::countr_zero(bits)};
-        for (auto y{first_y}; y <= last_y; ++y)
-          for (auto x{first_x}; x <= last_x; ++x) ++counts.at(bucket(entry.z, x, y, bit) + 1);
+        object_members.push_back(object.get());
+        object_graphics_order.push_back(object.get());
       }
     }
-    for (std::size_t index{}; index < buckets; ++index) counts.at(index + 1) += counts.at(index);
-    cursor.assign(counts.begin(), std::prev(counts.end()));
-    table.assign(insertions, collision::slot{});
-    for (std::size_t index{}; index < entries.size(); ++index)
+    else
     {
-      const auto &entry{entries.at(index)};
-      const auto first_x{entry.left >> shift};
-      const auto last_x{(entry.right - 1) >> shift};
-      const auto first_y{entry.bottom >> shift};
-      const auto last_y{(entry.top - 1) >> shift};
-      for (auto bits{entry.layer & sought}; bits != 0; bits &= bits - 1)
+      const auto limit{(object_graphics_order.size() * repair_factor) + repair_slack};
+      std::size_t moves{};
+      for (std::size_t index{1}; repaired && index < object_graphics_order.size(); ++index)
       {
-        const auto bit{std::countr_zero(bits)};
-        for (auto y{first_y}; y <= last_y; ++y)
-          for (auto x{first_x}; x <= last_x; ++x)
+        auto *current{object_graphics_order.at(index)};
+        auto position{index};
+        for (; position > 0 && before(current, object_graphics_order.at(position - 1)); --position)
+          object_graphics_order.at(position) = object_graphics_order.at(position - 1);
+        object_graphics_order.at(position) = current;
+        moves += index - position;
+        repaired = moves <= limit;
+      }
+    }
+    if (!repaired) std::ranges::sort(object_graphics_order, before);
+
+    light_graphics_order.clear();
+    for (light_graphics_order.reserve(lights.size()); const auto &light : lights)
+      light_graphics_order.emplace_back(light.get());
+    std::ranges::sort(light_graphics_order, [](const cse::light *left, const cse::light *right)
+                      { return left->name.identifier() < right->name.identifier(); });
+  }
+}
+
+namespace cse
+{
+  std::vector<hit> scene::overlapping(const rectangle &area, const double z, const collider mask) const
+  {
+    std::vector<hit> result{};
+    const auto shift{active.contact_shift};
+    if (shift < 0 || area.right <= area.left || area.top <= area.bottom) return result;
+    const auto left{help::collision::quantize(std::floor(area.left))};
+    const auto bottom{help::collision::quantize(std::floor(area.bottom))};
+    const auto right{help::collision::quantize(std::ceil(area.right))};
+    const auto top{help::collision::quantize(std::ceil(area.top))};
+    const auto depth{help::collision::quantize(std::floor(z + 0.5))};
+    for (std::size_t group{}; group < active.contact_groups.size(); ++group)
+    {
+      if (!active.contact_groups.at(group).layer.intersects(mask)) continue;
+      for (const auto *grid : std::array{&active.contact_grid, &active.contact_fixed})
+        for (auto y{bottom >> shift}; y <= (top - 1) >> shift; ++y)
+          for (auto x{left >> shift}; x <= (right - 1) >> shift; ++x)
           {
-            auto &position{cursor.at(bucket(entry.z, x, y, bit))};
-            table.at(position) = {static_cast<std::uint32_t>(index), x, y, bit};
-            ++position;
+            const auto found{grid->find({depth, x, y, static_cast<std::uint32_t>(group)})};
+            if (found == grid->end()) continue;
+            for (const auto &member : found->second.members)
+            {
+              const auto &body{active.contact_bodies.at(member.object)};
+              const auto &entry{body.entries.at(member.entry)};
+              if (std::max(entry.left >> shift, left >> shift) != x) continue;
+              if (std::max(entry.bottom >> shift, bottom >> shift) != y) continue;
+              const auto &box{body.boxes.at(member.entry)};
+              if (!help::collision::overlaps(rectangle{box.left, box.top, box.right, box.bottom}, area)) continue;
+              result.push_back({active.contact_members.at(member.object), box});
+            }
           }
+    }
+    return result;
+  }
+
+  std::vector<hit> scene::under(const glm::dvec2 &point, const double z, const collider mask) const
+  {
+    std::vector<hit> result{};
+    const auto shift{active.contact_shift};
+    if (shift < 0) return result;
+    const auto x{help::collision::quantize(std::floor(point.x)) >> shift};
+    const auto y{help::collision::quantize(std::floor(point.y)) >> shift};
+    const auto depth{help::collision::quantize(std::floor(z + 0.5))};
+    for (std::size_t group{}; group < active.contact_groups.size(); ++group)
+    {
+      if (!active.contact_groups.at(group).layer.intersects(mask)) continue;
+      for (const auto *grid : std::array{&active.contact_grid, &active.contact_fixed})
+      {
+        const auto found{grid->find({depth, x, y, static_cast<std::uint32_t>(group)})};
+        if (found == grid->end()) continue;
+        for (const auto &member : found->second.members)
+        {
+          const auto &body{active.contact_bodies.at(member.object)};
+          const auto &box{body.boxes.at(member.entry)};
+          if (point.x < box.left || point.x >= box.right || point.y < box.bottom || point.y >= box.top) continue;
+          result.push_back({active.contact_members.at(member.object), box});
+        }
       }
     }
+    return result;
+  }
 
-    const auto examine{[&](const std::size_t self_index, const collision::entry &self, const std::int32_t x,
-                           const std::int32_t y, const int bit)
-                       {
-                         const auto place{bucket(self.z, x, y, bit)};
-                         const auto first{counts.at(place)};
-                         const auto last{counts.at(place + 1)};
-                         for (auto position{first}; position != last; ++position)
-                         {
-                           const auto &held{*std::next(table.begin(), static_cast<std::ptrdiff_t>(position))};
-                           if (held.bit != bit || held.x != x || held.y != y) continue;
-                           const std::size_t candidate{held.entry};
-                           const auto &other{*std::next(entries.begin(), static_cast<std::ptrdiff_t>(candidate))};
-                           const auto shared{self.target & other.layer};
-                           if (shared == 0 || std::countr_zero(shared) != bit) continue;
-                           if ((other.target & self.layer) != 0 && candidate <= self_index) continue;
-                           if (std::max(self.left >> shift, other.left >> shift) != x) continue;
-                           if (std::max(self.bottom >> shift, other.bottom >> shift) != y) continue;
-                           attempt(self_index, candidate);
-                         }
-                       }};
+  std::vector<contact> scene::touching(const cse::name object_name) const
+  {
+    std::vector<contact> result{};
+    const auto object{active.objects.find(object_name)};
+    if (!object || object->slot + 1 >= active.contact_offsets.size() ||
+        active.contact_members.at(object->slot) != object.get())
+      return result;
+    const auto &source{active.contact_carried ? previous.contacts : active.contacts};
+    const auto first{active.contact_offsets.at(object->slot)};
+    const auto last{active.contact_offsets.at(object->slot + 1)};
+    result.reserve(last - first);
+    for (auto position{first}; position < last; ++position)
+      result.push_back(source.at(active.contact_positions.at(position)));
+    return result;
+  }
+
+  std::vector<hit> scene::cast(const ray &segment) const { return cast(std::span{&segment, 1}).front(); }
+
+  std::optional<hit> scene::first(const ray &segment) const { return first(std::span{&segment, 1}).front(); }
+
+  std::vector<std::vector<hit>> scene::cast(const std::span<const ray> segments) const
+  {
+    std::vector<std::vector<hit>> result{};
+    result.reserve(segments.size());
+    std::vector<std::pair<double, help::collision::held>> found{};
+    for (const auto &segment : segments)
+    {
+      march(segment, false, found);
+      auto &hits{result.emplace_back()};
+      hits.reserve(found.size());
+      for (const auto &[fraction, member] : found)
+        hits.push_back({active.contact_members.at(member.object),
+                        active.contact_bodies.at(member.object).boxes.at(member.entry), fraction});
+    }
+    return result;
+  }
 
-    for (std::size_t index{}; index < entries.size(); ++index)
+  std::vector<std::optional<hit>> scene::first(const std::span<const ray> segments) const
+  {
+    std::vector<std::optional<hit>> result{};
+    result.reserve(segments.size());
+    std::vector<std::pair<double, help::collision::held>> found{};
+    for (const auto &segment : segments)
     {
-      const auto &self{entries.at(index)};
-      if ((self.target & present) == 0) continue;
-      const auto first_x{self.left >> shift};
-      const auto last_x{(self.right - 1) >> shift};
-      const auto first_y{self.bottom >> shift};
-      const auto last_y{(self.top - 1) >> shift};
-      for (auto bits{self.target & present}; bits != 0; bits &= bits - 1)
+      march(segment, true, found);
+      if (found.empty())
       {
-        const auto bit{std::countr_zero(bits)};
-        for (auto y{first_y}; y <= last_y; ++y)
-          for (auto x{first_x}; x <= last_x; ++x) examine(index, self, x, y, bit);
+        result.emplace_back();
+        continue;
       }
+      const auto &[fraction, member]{found.front()};
+      result.emplace_back(hit{active.contact_members.at(member.object),
+                              active.contact_bodies.at(member.object).boxes.at(member.entry), fraction});
     }
+    return result;
   }
 
-  void active::generate_graphics_order(const double alpha)
+  void scene::march(const ray &segment, const bool nearest,
+                    std::vector<std::pair<double, help::collision::held>> &found) const
   {
-    object_graphics_order.clear();
-    for (object_graphics_order.reserve(objects.size()); const auto &object : objects)
-      object_graphics_order.emplace_back(object.get());
-    auto camera_translation = camera->active.translation.interpolated(camera->previous.translation, alpha);
-    auto camera_forward = glm::normalize(camera->active.forward.interpolated(camera->previous.forward, alpha));
-    std::ranges::sort(object_graphics_order,
-                      [alpha, &camera_translation, &camera_forward](const auto &left, const auto &right)
-                      {
-                        const auto layer_depth = [&](const auto *object)
+    found.clear();
+    const auto shift{active.contact_shift};
+    if (shift < 0 || segment.mask.empty()) return;
+    constexpr auto infinity{std::numeric_limits<double>::infinity()};
+    const auto size{static_cast<double>(std::int64_t{1} << shift)};
+    const auto delta{segment.end - segment.start};
+    const auto depth{help::collision::quantize(std::floor(segment.z + 0.5))};
+    auto x{help::collision::quantize(std::floor(segment.start.x)) >> shift};
+    auto y{help::collision::quantize(std::floor(segment.start.y)) >> shift};
+    const auto last_x{help::collision::quantize(std::floor(segment.end.x)) >> shift};
+    const auto last_y{help::collision::quantize(std::floor(segment.end.y)) >> shift};
+    const auto step_x{delta.x > 0.0 ? 1 : -1};
+    const auto step_y{delta.y > 0.0 ? 1 : -1};
+    const auto boundary{[size](const std::int32_t cell, const double origin, const double direction)
                         {
-                          const auto position =
-                            object->active.translation.interpolated(object->previous.translation, alpha);
-                          return (std::floor(position.z + 0.5) - camera_translation.z) * camera_forward.z;
-                        };
-                        const double left_depth = layer_depth(left);
-                        const double right_depth = layer_depth(right);
-                        if (!equal(left_depth, right_depth, 1e-4)) return left_depth > right_depth;
-                        if (left->active.priority.rendering != right->active.priority.rendering)
-                          return left->active.priority.rendering < right->active.priority.rendering;
-                        if (const auto *left_batch{left->active.texture.source.image.data.data()},
-                            *right_batch{right->active.texture.source.image.data.data()};
-                            left_batch != right_batch)
-                          return left_batch < right_batch;
-                        return left->name.identifier() < right->name.identifier();
-                      });
-
-    light_graphics_order.clear();
-    for (light_graphics_order.reserve(lights.size()); const auto &light : lights)
-      light_graphics_order.emplace_back(light.get());
-    std::ranges::sort(light_graphics_order, [](const cse::light *left, const cse::light *right)
-                      { return left->name.identifier() < right->name.identifier(); });
+                          if (direction == 0.0) return infinity;
+                          const auto edge{direction > 0.0 ? std::int64_t{cell} + 1 : std::int64_t{cell}};
+                          return ((static_cast<double>(edge) * size) - origin) / direction;
+                        }};
+    auto next_x{boundary(x, segment.start.x, delta.x)};
+    auto next_y{boundary(y, segment.start.y, delta.y)};
+    const auto span_x{delta.x == 0.0 ? infinity : size / std::abs(delta.x)};
+    const auto span_y{delta.y == 0.0 ? infinity : size / std::abs(delta.y)};
+    auto best{infinity};
+    while (true)
+    {
+      for (std::size_t group{}; group < active.contact_groups.size(); ++group)
+      {
+        if (!active.contact_groups.at(group).layer.intersects(segment.mask)) continue;
+        for (const auto *grid : std::array{&active.contact_grid, &active.contact_fixed})
+        {
+          const auto bucket{grid->find({depth, x, y, static_cast<std::uint32_t>(group)})};
+          if (bucket == grid->end()) continue;
+          for (const auto &member : bucket->second.members)
+          {
+            const auto &box{active.contact_bodies.at(member.object).boxes.at(member.entry)};
+            const auto fraction{help::collision::pierce(segment.start, delta, box)};
+            if (!fraction) continue;
+            found.emplace_back(*fraction, member);
+            best = std::min(best, *fraction);
+          }
+        }
+      }
+      if (x == last_x && y == last_y) break;
+      if (nearest && best <= std::min(next_x, next_y)) break;
+      if (y == last_y || (x != last_x && next_x < next_y))
+      {
+        x += step_x;
+        next_x += span_x;
+      }
+      else
+      {
+        y += step_y;
+        next_y += span_y;
+      }
+    }
+    std::ranges::sort(found);
+    found.erase(std::ranges::unique(found).begin(), found.end());
+    if (nearest && found.size() > 1) found.resize(1);
   }
-}
 
-namespace cse
-{
   void scene::pre_prepare() {}
   void scene::post_prepare() {}
   void scene::prepare()
@@ -393,6 +841,7 @@ namespace cse
   {
     if (active.phase != help::phase::CREATED)
       throw exception("Scene '{}' must be created before synchronization", name.string());
+    CSE_TRACE_ZONE("scene::synchronize");
     pre_synchronize();
     active.synchronize(previous);
     if (next.camera.has_value())
@@ -482,6 +931,7 @@ namespace cse
   {
     if (active.phase != help::phase::CREATED)
       throw exception("Scene '{}' must be created before processing events", name.string());
+    CSE_TRACE_ZONE("scene::event");
     pre_event(event);
     for (const auto &interface : active.interface_simulation_order) interface->event(event);
     active.camera->event(event);
@@ -496,12 +946,28 @@ namespace cse
   {
     if (active.phase != help::phase::CREATED)
       throw exception("Scene '{}' must be created before simulation", name.string());
+    CSE_TRACE_ZONE("scene::simulate");
     pre_simulate(tick);
     active.timer.simulate(tick);
     active.mixer.simulate(tick);
     for (const auto &interface : active.interface_simulation_order) interface->simulate(tick);
     active.camera->simulate(tick);
-    for (const auto &object : active.object_simulation_order) object->simulate(tick);
+    const auto &order{active.object_simulation_order};
+    for (std::size_t first{}; first < order.size();)
+    {
+      const auto &priority{order.at(first)->active.priority};
+      auto last{first + 1};
+      if (priority.parallel)
+        while (last < order.size() && order.at(last)->active.priority.parallel &&
+               order.at(last)->active.priority.simulation == priority.simulation)
+          ++last;
+      if (last - first == 1)
+        order.at(first)->simulate(tick);
+      else
+        game->active.worker.run(last - first, [&order, first, tick](const std::size_t index)
+                                { order.at(first + index)->simulate(tick); });
+      first = last;
+    }
     for (const auto &light : active.light_simulation_order) light->simulate(tick);
     post_simulate(tick);
   }
@@ -512,8 +978,10 @@ namespace cse
   {
     if (active.phase != help::phase::CREATED)
       throw exception("Scene '{}' must be created before collision", name.string());
+    CSE_TRACE_ZONE("scene::collide");
     pre_collide(tick);
-    for (active.generate_contacts(); const auto &object : active.object_simulation_order) object->collide(tick);
+    active.generate_contacts(game->active.worker, previous);
+    for (const auto &object : active.object_simulation_order) object->collide(tick);
     post_collide(tick);
   }
 
@@ -523,6 +991,7 @@ namespace cse
   {
     if (active.phase != help::phase::CREATED)
       throw exception("Scene '{}' must be created before rendering", name.string());
+    CSE_TRACE_ZONE("scene::render");
     pre_render(alpha);
     active.render(game->active, aspect, alpha);
     post_render(alpha);
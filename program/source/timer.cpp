@@ -11,13 +11,14 @@ namespace cse::help
 {
   timer &timer::operator=(const timer &other)
   {
-    if (this == &other) return *this;
+    if (this == &other || revision == other.revision) return *this;
     std::erase_if(entries, [&other](const auto &item) { return !other.entries.contains(item.first); });
     for (const auto &[name, target] : other.entries)
       if (const auto iterator{entries.find(name)}; iterator != entries.end())
         iterator->second = target;
       else
         entries.emplace(name, target);
+    revision = other.revision;
     return *this;
   }
 
@@ -29,6 +30,7 @@ namespace cse::help
   {
     auto iterator{entries.find(name)};
     if (iterator == entries.end()) throw exception("Attempted to get non-existent timer '{}'", name.string());
+    ++revision;
     return iterator->second.state;
   }
 
@@ -39,14 +41,22 @@ namespace cse::help
     return iterator->second.state;
   }
 
-  void timer::remove(const name name) noexcept { entries.erase(name); }
+  void timer::remove(const name name) noexcept
+  {
+    if (entries.erase(name) != 0) ++revision;
+  }
 
   void timer::remove(std::initializer_list<name> names) noexcept
   {
-    for (const auto &name : names) entries.erase(name);
+    for (const auto &name : names) remove(name);
   }
 
-  void timer::clear() noexcept { entries.clear(); }
+  void timer::clear() noexcept
+  {
+    if (entries.empty()) return;
+    entries.clear();
+    ++revision;
+  }
 
   bool timer::ready(const name name) const
   {
@@ -58,11 +68,16 @@ namespace cse::help
   void timer::simulate(const double tick)
   {
     for (auto &[name, target] : entries)
-      if (target.state.running) target.state.elapsed += tick;
+      if (target.state.running)
+      {
+        target.state.elapsed += tick;
+        ++revision;
+      }
   }
 
   void timer::finish(std::unordered_map<name, entry>::iterator iterator)
   {
+    ++revision;
     if (iterator->second.state.repeat)
       iterator->second.state.elapsed = 0.0;
     else
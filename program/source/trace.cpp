@@ -0,0 +1,80 @@
+#include "trace.hpp"
+
+#if defined(CSE_TRACE)
+  #include <atomic>
+  #include <cstdint>
+  #include <format>
+  #include <fstream>
+  #include <ios>
+  #include <memory>
+  #include <mutex>
+
+  #include "SDL3/SDL_timer.h"
+
+  #include "log.hpp"
+  #include "meta.hpp"
+
+namespace cse::help::trace
+{
+  ring::ring(const std::uint32_t thread_) : identifier{thread_} {}
+
+  void ring::push(const char *label, const std::uint64_t begin, const std::uint64_t end) noexcept
+  {
+    const auto index{head.load(std::memory_order_relaxed)};
+    auto &slot{events.at(index & (capacity - 1))};
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.label.store(label, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    head.store(index + 1, std::memory_order_release);
+  }
+
+  std::uint32_t ring::thread() const noexcept { return identifier; }
+
+  zone::zone(const char *label_) noexcept : label{label_}, begin{SDL_GetTicksNS()} {}
+
+  zone::~zone() { local().push(label, begin, SDL_GetTicksNS()); }
+
+  ring &local()
+  {
+    thread_local ring *owned{};
+    if (owned) return *owned;
+    const std::scoped_lock<std::mutex> lock(registry_mutex);
+    registry.push_back(std::make_unique<ring>(static_cast<std::uint32_t>(registry.size() + 1)));
+    owned = registry.back().get();
+    return *owned;
+  }
+
+  bool flush()
+  {
+    if (!meta.output)
+    {
+      log("No access to user local directory, skipping trace write");
+      return false;
+    }
+    std::ofstream stream{meta.output.value() / "trace.json", std::ios::trunc};
+    if (!stream)
+    {
+      log("Could not open trace file for writing");
+      return false;
+    }
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first{true};
+    const std::scoped_lock<std::mutex> lock(registry_mutex);
+    for (const auto &owner : registry)
+      owner->iterate(
+        [&](const ring::sample &sample)
+        {
+          stream << std::format("{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                first ? "" : ",", sample.label, owner->thread(),
+                                static_cast<double>(sample.begin) / 1e3,
+                                static_cast<double>(sample.end - sample.begin) / 1e3);
+          first = false;
+        });
+    stream << "]}\n";
+    return static_cast<bool>(stream);
+  }
+}
+#endif
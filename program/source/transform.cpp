@@ -1,35 +1,35 @@
 #include "transform.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 
 #include "glm/ext/vector_double2.hpp"
+#include "glm/ext/vector_double3.hpp"
 
+#include "container.hpp"
 #include "numeric.hpp"
+#include "object.hpp"
 #include "resource.hpp"
 
+namespace
+{
+  constexpr std::array<std::array<double, 2>, 4> quarter_turns{{{1.0, 0.0}, {0.0, -1.0}, {-1.0, 0.0}, {0.0, 1.0}}};
+}
+
 namespace cse::help::transform
 {
   glm::dvec2 rotate(const glm::dvec2 &value, const int steps)
   {
-    switch (((steps % 4) + 4) % 4)
-    {
-      case 1: return {value.y, -value.x};
-      case 2: return {-value.x, -value.y};
-      case 3: return {-value.y, value.x};
-      default: return value;
-    }
+    const auto [cosine, sine]{quarter_turns.at(static_cast<std::size_t>(((steps % 4) + 4) % 4))};
+    return {(cosine * value.x) - (sine * value.y), (sine * value.x) + (cosine * value.y)};
   }
 
   glm::dvec2 unrotate(const glm::dvec2 &value, const int steps)
   {
-    switch (((steps % 4) + 4) % 4)
-    {
-      case 1: return {-value.y, value.x};
-      case 2: return {-value.x, -value.y};
-      case 3: return {value.y, -value.x};
-      default: return value;
-    }
+    const auto [cosine, sine]{quarter_turns.at(static_cast<std::size_t>(((steps % 4) + 4) % 4))};
+    return {(cosine * value.x) + (sine * value.y), (cosine * value.y) - (sine * value.x)};
   }
 
   cse::rectangle turn(const cse::rectangle &value, const int steps)
@@ -59,9 +59,31 @@ namespace cse::help::transform
     return grid(extent_x, extent_y) - rotated;
   }
 
+  placement place(const glm::dvec3 &translation, const int steps, const glm::dvec2 &offset, const glm::dvec2 &size)
+  {
+    const auto shift{rotate(offset, steps)};
+    return {{translation.x + shift.x, translation.y + shift.y, translation.z}, size, ((steps % 4) + 4) % 4};
+  }
+
   double snap_x(const double center, const double size)
   { return static_cast<int>(size) % 2 == 0 ? std::floor(center) + 0.5 : std::floor(center + 0.5); }
 
   double snap_y(const double center, const double size)
   { return static_cast<int>(size) % 2 == 0 ? std::ceil(center) - 0.5 : std::ceil(center - 0.5); }
+
+  void store::gather(const help::container<cse::object> &objects, const double alpha)
+  {
+    const auto count{objects.size()};
+    translation.resize(count);
+    rotation.resize(count);
+    scale.resize(count);
+    for (std::size_t slot{}; slot < count; ++slot)
+    {
+      auto &object{*objects.at(slot)};
+      object.slot = slot;
+      translation.at(slot) = object.active.translation.interpolated(object.previous.translation, alpha);
+      rotation.at(slot) = object.active.rotation.interpolated(object.previous.rotation, alpha);
+      scale.at(slot) = object.active.scale.interpolated(object.previous.scale, alpha);
+    }
+  }
 }
@@ -99,16 +99,7 @@ namespace cse::help::window
     last.mixer = mixer;
     last.phase = phase;
 
-    for (auto &[name, sound] : mixer.sounds)
-    {
-      sound.speed.instant = false;
-      sound.volume.instant = false;
-    }
-    for (auto &[name, music] : mixer.musics)
-    {
-      music.speed.instant = false;
-      music.volume.instant = false;
-    }
+    mixer.settle();
     mouse.wheel = {};
   }
 
@@ -738,10 +729,10 @@ namespace cse
   void window::create(SDL_GPUDevice *video, const help::game::aspect &aspect)
   {
     if (active.phase != help::phase::PREPARED) throw exception("Window must be prepared before creation");
-    active.create(video, aspect);
+    if (video) active.create(video, aspect);
     active.phase = help::phase::CREATED;
     on_create();
-    active.reconcile(video);
+    if (video) active.reconcile(video);
   }
 
   void window::on_synchronize() {}
@@ -791,7 +782,7 @@ namespace cse
   void window::destroy(SDL_GPUDevice *video)
   {
     if (active.phase != help::phase::CREATED) throw exception("Window must be created before destruction");
-    active.destroy(video);
+    if (video) active.destroy(video);
     active.phase = help::phase::PREPARED;
     on_destroy();
   }
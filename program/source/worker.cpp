@@ -0,0 +1,104 @@
+#include "worker.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace cse::help
+{
+  worker::~worker() { stop(); }
+
+  void worker::start(const std::size_t count)
+  {
+    stop();
+    stopping = false;
+    generation = 0;
+    threads.reserve(count);
+    for (std::size_t index{}; index < count; ++index) threads.emplace_back([this]() { loop(); });
+  }
+
+  void worker::stop()
+  {
+    if (threads.empty()) return;
+    {
+      const std::scoped_lock<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads)
+      if (thread.joinable()) thread.join();
+    threads.clear();
+  }
+
+  std::size_t worker::size() const noexcept { return threads.size(); }
+
+  void worker::run(const std::size_t count, const job &function)
+  {
+    if (count == 0) return;
+    std::unique_lock<std::mutex> owner(claim, std::try_to_lock);
+    if (threads.empty() || count == 1 || !owner.owns_lock())
+    {
+      for (std::size_t index{}; index < count; ++index) function(index);
+      return;
+    }
+
+    {
+      const std::scoped_lock<std::mutex> lock(mutex);
+      current = &function;
+      total = count;
+      cursor.store(0);
+      busy = threads.size();
+      failure = nullptr;
+      ++generation;
+    }
+    wake.notify_all();
+    drain();
+    std::exception_ptr caught{};
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [this]() { return busy == 0; });
+      current = nullptr;
+      caught = failure;
+      failure = nullptr;
+    }
+    if (caught) std::rethrow_exception(caught);
+  }
+
+  void worker::loop()
+  {
+    std::uint64_t seen{};
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this, &seen]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+      }
+      drain();
+      {
+        const std::scoped_lock<std::mutex> lock(mutex);
+        if (--busy == 0) done.notify_one();
+      }
+    }
+  }
+
+  void worker::drain()
+  {
+    for (auto index{cursor.fetch_add(1)}; index < total; index = cursor.fetch_add(1))
+    {
+      try
+      {
+        (*current)(index);
+      }
+      catch (...)
+      {
+        const std::scoped_lock<std::mutex> lock(mutex);
+        if (!failure) failure = std::current_exception();
+        cursor.store(total);
+      }
+    }
+  }
+}
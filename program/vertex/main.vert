@@ -1,14 +1,12 @@
 struct Input
 {
-  float4 corner : TEXCOORD0;         // xy = quad corner position (-1..1), zw = quad corner uv (0..1)
-  float4 model_column_0 : TEXCOORD1; // model matrix column 0 (per instance)
-  float4 model_column_1 : TEXCOORD2; // model matrix column 1
-  float4 model_column_2 : TEXCOORD3; // model matrix column 2
-  float4 model_column_3 : TEXCOORD4; // model matrix column 3
-  float4 color : TEXCOORD5;          // xyz = tint colour, w = tint strength
-  float4 frame : TEXCOORD6;          // xy = frame uv min (left, bottom), zw = max (right, top)
-  float4 material : TEXCOORD7;       // x = lit, y = shadowed, z = brightness, w = transparency
-  float2 meta : TEXCOORD8;           // x = depth bias (NDC, nearer = larger), y = occluder index (-1 = none)
+  float4 corner : TEXCOORD0;   // xy = quad corner position (-1..1), zw = quad corner uv (0..1)
+  float3 position : TEXCOORD1; // xyz = pixel-snapped quad centre (per instance)
+  int2 size : TEXCOORD2;       // xy = quad size in pixels, sign carries mirroring
+  float4 color : TEXCOORD3;    // xyz = tint colour, w = tint strength
+  float4 frame : TEXCOORD4;    // xy = frame uv min (left, bottom), zw = max (right, top)
+  float2 meta : TEXCOORD5;     // x = depth bias (NDC, nearer = larger), y = brightness
+  uint flags : TEXCOORD6;      // 0-1 = quarter turns, 2 = lit, 3 = shadowed, 4-11 = transparency, 12-31 = occluder + 1
 };
 struct Output
 {
@@ -25,13 +23,21 @@ cbuffer matrices : register(b0, space1)
   float4x4 view_matrix;
 };
 
+static const float2 quarter_turns[4] = {float2(1.0f, 0.0f), float2(0.0f, -1.0f), float2(-1.0f, 0.0f),
+                                        float2(0.0f, 1.0f)};
+
 Output main(Input input)
 {
-  float4x4 model_matrix = {input.model_column_0, input.model_column_1, input.model_column_2, input.model_column_3};
-  float4 world_position = mul(float4(input.corner.xy, 0.0f, 1.0f), model_matrix);
+  float2 turn = quarter_turns[input.flags & 3u];
+  float2 local = input.corner.xy * (float2)input.size * 0.5f;
+  float2 rotated = float2(turn.x * local.x - turn.y * local.y, turn.y * local.x + turn.x * local.y);
+  float4 world_position = float4(input.position.xy + rotated, input.position.z, 1.0f);
   float4 clip = mul(projection_matrix, mul(view_matrix, world_position));
   clip.z -= input.meta.x * clip.w;
+  float occluder = (float)(input.flags >> 12) - 1.0f;
+  float4 material = float4((float)((input.flags >> 2) & 1u), (float)((input.flags >> 3) & 1u), input.meta.y,
+                           (float)((input.flags >> 4) & 0xFFu) / 255.0f);
   Output output = {clip, input.color, lerp(input.frame.xy, input.frame.zw, input.corner.zw),
-                   float4(world_position.xyz, input.meta.y), input.material};
+                   float4(world_position.xyz, occluder), material};
   return output;
 }